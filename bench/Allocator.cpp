@@ -0,0 +1,71 @@
+// Copyright (c) 2026- b0owl / Brennan Marx-Rennie. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to use,
+// copy, modify, and distribute the Software for NON-COMMERCIAL purposes only,
+// subject to the following conditions:
+//
+// 1. The above copyright notice and this permission notice shall be included
+//    in all copies or substantial portions of the Software.
+// 2. The Software may not be used for commercial purposes without prior
+//    written permission from the copyright holder.
+// 3. Commercial use includes, but is not limited to, selling the Software,
+//    using it in a commercial product, or using it to provide commercial services.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+
+#include "bench.h"
+#include "../engine/include/allocator.h"
+
+static DrawData make_quad(float x, float y) {
+    return DrawData{ { 0.0f, 0.0f, 1.0f, 0.0f, 1.0f, 1.0f, 0.0f, 1.0f }, 4,
+                     1.0f, 1.0f, 1.0f, x, y, 1.0f, 1.0f };
+}
+
+void bench_allocator() {
+    // create_pointers + one heap object per slot, freed by the destructor
+    for (int n : { 1000, 100000 }) {
+        std::string name = "allocator/store_free/" + std::to_string(n);
+        bench_run(name.c_str(), n, [n] {
+            Allocator allocator;
+            allocator.create_pointers(n);
+            for (int i = 0; i < n; i++) allocator.store_ptr(new DrawData(make_quad((float)i, 0.0f)));
+            bench_keep(allocator.ptr);
+        });
+    }
+    // the same objects taken from a DrawPool, then handed back
+    for (int n : { 1000, 100000 }) {
+        std::string name = "allocator/pool_store_free/" + std::to_string(n);
+        bench_run(name.c_str(), n, [n] {
+            DrawPool pool;
+            std::vector<DrawData*> objects(n);
+            for (int i = 0; i < n; i++) objects[i] = pool.create(make_quad((float)i, 0.0f));
+            for (int i = 0; i < n; i++) pool.destroy(objects[i]);
+            bench_keep(objects.data());
+        });
+    }
+    // per-frame objects from a FrameAllocator, reset every iteration
+    for (int n : { 1000, 100000 }) {
+        std::string name = "allocator/frame_store/" + std::to_string(n);
+        FrameAllocator frame(sizeof(DrawData) * 100000);
+        frame.create_pointers(n);
+        bench_run(name.c_str(), n, [n, &frame] {
+            for (int i = 0; i < n; i++) frame.store_ptr(frame.create<DrawData>(make_quad((float)i, 0.0f)));
+            bench_keep(frame.ptr);
+            frame.end_frame();
+        });
+    }
+    // spawn/despawn churn: erase a third of the objects, then refill the holes
+    for (int n : { 1000, 100000 }) {
+        std::string name = "allocator/static_churn/" + std::to_string(n);
+        StaticAllocator objects;
+        std::vector<StaticHandle> handles(n);
+        for (int i = 0; i < n; i++) handles[i] = objects.store_ptr(draw_pool_default().create(make_quad((float)i, 0.0f)));
+        bench_run(name.c_str(), n / 3 * 2, [&] {
+            for (int i = 0; i < n; i += 3) objects.erase(handles[i]);
+            for (int i = 0; i < n; i += 3) handles[i] = objects.store_ptr(draw_pool_default().create(make_quad((float)i, 0.0f)));
+        });
+    }
+}
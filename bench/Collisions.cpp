@@ -0,0 +1,154 @@
+// Copyright (c) 2026- b0owl / Brennan Marx-Rennie. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to use,
+// copy, modify, and distribute the Software for NON-COMMERCIAL purposes only,
+// subject to the following conditions:
+//
+// 1. The above copyright notice and this permission notice shall be included
+//    in all copies or substantial portions of the Software.
+// 2. The Software may not be used for commercial purposes without prior
+//    written permission from the copyright holder.
+// 3. Commercial use includes, but is not limited to, selling the Software,
+//    using it in a commercial product, or using it to provide commercial services.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+
+#include "bench.h"
+#include "../engine/include/collisions.h"
+#include "../engine/include/bitboard.h"
+
+void bench_collisions() {
+    for (int n : { 1000, 10000, 100000 }) {
+        Allocator allocator;
+        allocator.create_pointers(n);
+        for (int i = 0; i < n; i++) {
+            allocator.store_ptr(new DrawData{ { 0.0f, 0.0f, 1.0f, 0.0f, 1.0f, 1.0f, 0.0f, 1.0f }, 4,
+                                              1.0f, 1.0f, 1.0f, (float)(i % 1000), (float)(i / 1000),
+                                              1.0f, 1.0f });
+        }
+
+        std::vector<DrawData> a, b;
+        std::string name = "collisions/is_colliding/" + std::to_string(n);
+        bench_run(name.c_str(), 1, [&] {
+            a.clear();
+            b.clear();
+            bool hit = is_colliding(allocator, a, b);
+            bench_keep(hit);
+        });
+    }
+
+    // broadphase over moving objects: rebuild and collect every pair, once per frame
+    for (int n : { 1000, 10000 }) {
+        std::vector<DrawData> objects(n);
+        std::vector<void*> ptr(n);
+        for (int i = 0; i < n; i++) {
+            objects[i] = DrawData{ { 0.0f, 0.0f, 16.0f, 0.0f, 16.0f, 16.0f, 0.0f, 16.0f }, 4,
+                                   1.0f, 1.0f, 1.0f, (float)((i * 7919) % 4000), (float)((i * 104729) % 4000),
+                                   16.0f, 16.0f };
+            ptr[i] = &objects[i];
+        }
+
+        SpatialHash grid(32.0f);
+        std::string name = "collisions/spatial_hash_pairs/" + std::to_string(n);
+        bench_run(name.c_str(), n, [&] {
+            for (DrawData& o : objects) o.x += 1.0f;
+            grid.build(ptr.data(), n);
+            bench_keep(grid.pairs().data());
+        });
+    }
+
+    // incremental broadphase, 10% of the objects moving each iteration
+    for (int n : { 1000, 10000 }) {
+        std::vector<DrawData> objects(n);
+        SweepAndPrune sap;
+        for (int i = 0; i < n; i++) {
+            objects[i] = DrawData{ { 0.0f }, 4, 1.0f, 1.0f, 1.0f, (float)((i * 7919) % 4000),
+                                   (float)((i * 104729) % 4000), 16.0f, 16.0f };
+            sap.add(&objects[i]);
+        }
+        sap.update();
+
+        float step = 1.0f;
+        std::string name = "collisions/sweep_and_prune/" + std::to_string(n);
+        bench_run(name.c_str(), n, [&] {
+            for (int i = 0; i < n; i += 10) objects[i].x += step;
+            step = -step;
+            sap.update();
+            bench_keep(sap.began().data());
+        });
+    }
+
+    // point picking against a tree of static boxes
+    for (int n : { 10000, 100000 }) {
+        AabbTree tree;
+        for (int i = 0; i < n; i++) tree.add_box((float)((i * 7919) % 10000), (float)((i * 104729) % 10000), 10.0f, 10.0f);
+
+        std::vector<int> hits;
+        int probe = 0;
+        std::string name = "collisions/aabb_tree_point/" + std::to_string(n);
+        bench_run(name.c_str(), 1, [&] {
+            probe = (probe + 7727) % 10000;
+            bench_keep(tree.query_point((float)probe, (float)((probe * 31) % 10000), hits));
+        });
+    }
+
+    // one box against many with the kernel, on every path the CPU has
+    {
+        const int n = 100000;
+        std::vector<DrawData> objects(n);
+        std::vector<void*> ptr(n);
+        for (int i = 0; i < n; i++) {
+            objects[i] = DrawData{ { 0.0f }, 4, 1.0f, 1.0f, 1.0f, (float)((i * 7919) % 10000),
+                                   (float)((i * 104729) % 10000), 10.0f, 10.0f };
+            ptr[i] = &objects[i];
+        }
+        BoxSoA boxes;
+        aabb_from_objects(ptr.data(), n, boxes);
+        std::vector<uint32_t> mask(aabb_mask_words(n));
+
+        AabbSimd best = aabb_simd();
+        const char* names[] = { "scalar", "sse2", "avx2" };
+        for (int path = 0; path <= (int)best; path++) {
+            aabb_set_simd((AabbSimd)path);
+            std::string name = std::string("collisions/aabb_mask/") + names[path] + "/100000";
+            bench_run(name.c_str(), n, [&] {
+                bench_keep(aabb_overlap_mask(500.0f, 500.0f, 600.0f, 600.0f, boxes, mask.data()));
+            });
+        }
+        aabb_set_simd(best);
+    }
+
+    // every rotation and column of a T piece on a half-full 10x24 board, the
+    // inner loop of a placement search
+    {
+        Bitboard board = bitboard_make(10, 24);
+        for (int y = 0; y < 10; y++)
+            for (int x = 0; x < 10; x++)
+                if ((x * 7 + y * 3) % 5 != 0) bitboard_set(board, x, y);
+        int cells[4][2] = { { 0, 0 }, { 1, 0 }, { 2, 0 }, { 1, 1 } };
+        PieceMask rotations[4];
+        rotations[0] = piece_from_cells(cells, 4);
+        for (int i = 1; i < 4; i++) rotations[i] = piece_rotate_cw(rotations[i - 1]);
+
+        int placements = 0;
+        for (const PieceMask& piece : rotations) placements += board.width - piece.width + 1;
+        std::string name = "collisions/bitboard_placements/" + std::to_string(placements);
+        bench_run(name.c_str(), placements, [&] {
+            int cleared = 0;
+            for (const PieceMask& piece : rotations) {
+                for (int x = 0; x + piece.width <= board.width; x++) {
+                    int y = board.height - piece.height;
+                    int d = bitboard_drop_distance(board, piece, x, y);
+                    if (d < 0) continue;
+                    Bitboard next = board;
+                    bitboard_place(next, piece, x, y - d);
+                    cleared += bitboard_clear_rows(next);
+                }
+            }
+            bench_keep(cleared);
+        });
+    }
+}
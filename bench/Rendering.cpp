@@ -0,0 +1,141 @@
+// Copyright (c) 2026- b0owl / Brennan Marx-Rennie. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to use,
+// copy, modify, and distribute the Software for NON-COMMERCIAL purposes only,
+// subject to the following conditions:
+//
+// 1. The above copyright notice and this permission notice shall be included
+//    in all copies or substantial portions of the Software.
+// 2. The Software may not be used for commercial purposes without prior
+//    written permission from the copyright holder.
+// 3. Commercial use includes, but is not limited to, selling the Software,
+//    using it in a commercial product, or using it to provide commercial services.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+
+// Draw submission runs on the null renderer (headless, no GL calls), so these
+// numbers are the engine's CPU cost per draw. Set BYTEE_HEADLESS=offscreen to
+// include a software GL driver, or BENCH_FONT to pick the font.
+
+#include "bench.h"
+#include "../engine/include/bytee.h"
+#include <cstdio>
+#include <cstdlib>
+
+static const char* SHEET_PATH = "bench_sheet.tga";
+static const char* TEXT = "The quick brown fox jumps over the lazy dog";
+
+// Uncompressed 32-bit TGA, 4x4 frames of 16x16 px; stb_image reads it without a PNG encoder.
+static bool write_sheet(const char* path) {
+    FILE* f = fopen(path, "wb");
+    if (!f) return false;
+    const int size = 64;
+    unsigned char header[18] = { 0, 0, 2 };
+    header[12] = size & 0xFF; header[13] = size >> 8;
+    header[14] = size & 0xFF; header[15] = size >> 8;
+    header[16] = 32;
+    header[17] = 0x28;  // top-left origin, 8 alpha bits
+    fwrite(header, 1, sizeof(header), f);
+    for (int y = 0; y < size; y++) {
+        for (int x = 0; x < size; x++) {
+            unsigned char px[4] = { (unsigned char)(x * 4), (unsigned char)(y * 4), 128, 255 };
+            fwrite(px, 1, 4, f);
+        }
+    }
+    return fclose(f) == 0;
+}
+
+static const char* find_font() {
+    if (const char* env = getenv("BENCH_FONT")) return env;
+    static const char* candidates[] = {
+        "/usr/share/fonts/truetype/dejavu/DejaVuSans.ttf",
+        "/usr/share/fonts/TTF/DejaVuSans.ttf",
+        "/usr/share/fonts/dejavu/DejaVuSans.ttf",
+        "/System/Library/Fonts/Supplemental/Arial.ttf",
+        "/Library/Fonts/Arial.ttf",
+        "C:/Windows/Fonts/arial.ttf",
+    };
+    for (const char* path : candidates) {
+        if (FILE* f = fopen(path, "rb")) { fclose(f); return path; }
+    }
+    return nullptr;
+}
+
+static void bench_text(const char* font, const char* mode) {
+    std::string prefix = std::string("text/") + mode + "/";
+
+    bench_run((prefix + "draw_text").c_str(), 100, [font] {
+        for (int i = 0; i < 100; i++) draw_text(font, TEXT, -1.0f, 0.0f, 0.05f, 1, 1, 1);
+        batch_flush();
+    });
+    bench_run((prefix + "get_text_width").c_str(), 1, [font] {
+        float w = get_text_width(font, TEXT, 0.05f);
+        bench_keep(w);
+    });
+    bench_run((prefix + "font_lookup").c_str(), 1, [font] {
+        float h = get_text_cap_height(font, 0.05f);
+        bench_keep(h);
+    });
+
+    TextMesh mesh;
+    build_text_mesh(mesh, font, TEXT, 0.05f);
+    bench_run((prefix + "text_mesh_unchanged").c_str(), 1, [&] {
+        bool rebuilt = build_text_mesh(mesh, font, TEXT, 0.05f);
+        bench_keep(rebuilt);
+    });
+    bench_run((prefix + "text_mesh_draw").c_str(), 100, [&] {
+        for (int i = 0; i < 100; i++) draw_text_mesh(mesh, -1.0f, 0.0f, 1, 1, 1);
+    });
+    free_text_mesh(mesh);
+}
+
+void bench_rendering() {
+    if (!getenv("BYTEE_HEADLESS")) set_headless_mode(HeadlessMode::Null);
+    GLFWwindow* window = create_window(1280, 720, "bench");
+    if (!window) { fprintf(stderr, "no window, skipping rendering benchmarks\n"); return; }
+    setup_2d_orthographic(window, { 0, 0, 0, 1 });
+
+    if (write_sheet(SHEET_PATH)) {
+        SpriteSheet sheet = load_spritesheet(SHEET_PATH, 4, 4);
+        bench_run("sprites/draw_sprite", 1000, [&] {
+            for (int i = 0; i < 1000; i++)
+                draw_sprite(sheet, i & 15, (i % 40) * 0.05f - 1.0f, (i / 40) * 0.05f - 1.0f, 0.05f, 0.05f);
+            batch_flush();
+        });
+        bench_run("sprites/spritesheet_cache_hit", 1, [] {
+            SpriteSheet s = load_spritesheet(SHEET_PATH, 4, 4);
+            bench_keep(s);
+        });
+        unload_image(SHEET_PATH);
+        remove(SHEET_PATH);
+    }
+
+    if (const char* font = find_font()) {
+        set_font_mode(FontMode::Bitmap);
+        bench_text(font, "bitmap");
+        set_font_mode(FontMode::SDF);
+        bench_text(font, "sdf");
+        set_font_mode(FontMode::Bitmap);
+    } else {
+        fprintf(stderr, "no font found (set BENCH_FONT), skipping text benchmarks\n");
+    }
+
+    {
+        Allocator shapes;
+        shapes.create_pointers(1000);
+        for (int i = 0; i < 1000; i++) {
+            shapes.store_ptr(new DrawData{ { 0.0f, 0.0f, 0.05f, 0.0f, 0.05f, 0.05f, 0.0f, 0.05f }, 4,
+                                           1.0f, 0.5f, 0.0f, (i % 40) * 0.05f - 1.0f, (i / 40) * 0.05f - 1.0f,
+                                           0.05f, 0.05f });
+        }
+        bench_run("shapes/draw_struct/1000", 1000, [&] {
+            shapes.draw_struct(shapes.ptr, shapes.m_pointers);
+        });
+    }  // frees its GL buffers while the context is still current
+
+    glCleanup(window);
+    glfwDestroyWindow(window);
+}
@@ -0,0 +1,93 @@
+// Copyright (c) 2026- b0owl / Brennan Marx-Rennie. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to use,
+// copy, modify, and distribute the Software for NON-COMMERCIAL purposes only,
+// subject to the following conditions:
+//
+// 1. The above copyright notice and this permission notice shall be included
+//    in all copies or substantial portions of the Software.
+// 2. The Software may not be used for commercial purposes without prior
+//    written permission from the copyright holder.
+// 3. Commercial use includes, but is not limited to, selling the Software,
+//    using it in a commercial product, or using it to provide commercial services.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+
+#ifndef BENCH_H
+#define BENCH_H
+
+// Microbenchmark harness for `make bench`.
+// bench_run calibrates an iteration count so one sample takes at least
+// BENCH_SAMPLE_MS, takes BENCH_SAMPLES samples and keeps the median and the
+// fastest, in nanoseconds per operation. Results are written as JSON by
+// bench_write_json and compared against a baseline by tools/bench_compare.py.
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+#define BENCH_SAMPLES   7
+#define BENCH_SAMPLE_MS 20.0
+
+struct BenchResult {
+    std::string name;
+    long long iterations;  // calls per sample
+    int ops_per_call;      // operations each call performs (e.g. 1000 sprites)
+    double ns_per_op;      // median sample
+    double min_ns_per_op;  // fastest sample
+};
+
+extern std::vector<BenchResult> bench_results;
+extern const char* bench_filter;
+
+// Keeps the compiler from discarding a value that is never read.
+template <typename T>
+inline void bench_keep(const T& value) {
+    asm volatile("" : : "g"(&value) : "memory");
+}
+
+bool bench_selected(const char* name);
+void bench_record(const char* name, long long iterations, int ops_per_call, std::vector<double>& samples_ns);
+
+/*
+@brief, times fn and records the result under name
+
+@param name,         result name, "group/case/size"
+@param ops_per_call, operations one call of fn performs; results are per operation
+@param fn,           the measured body
+*/
+template <typename Fn>
+void bench_run(const char* name, int ops_per_call, Fn fn) {
+    if (!bench_selected(name)) return;
+    using clock = std::chrono::steady_clock;
+
+    fn();  // warm caches and lazy initialization
+    long long iterations = 1;
+    for (;;) {
+        auto t0 = clock::now();
+        for (long long i = 0; i < iterations; i++) fn();
+        double ms = std::chrono::duration<double, std::milli>(clock::now() - t0).count();
+        if (ms >= BENCH_SAMPLE_MS || iterations >= (1LL << 40)) break;
+        iterations = ms <= 0.0 ? iterations * 10 : (long long)(iterations * BENCH_SAMPLE_MS * 1.2 / ms) + 1;
+    }
+
+    std::vector<double> samples;
+    for (int s = 0; s < BENCH_SAMPLES; s++) {
+        auto t0 = clock::now();
+        for (long long i = 0; i < iterations; i++) fn();
+        samples.push_back(std::chrono::duration<double, std::nano>(clock::now() - t0).count());
+    }
+    bench_record(name, iterations, ops_per_call, samples);
+}
+
+bool bench_write_json(const char* path);
+
+// Suites, one per file
+void bench_rendering();
+void bench_collisions();
+void bench_allocator();
+
+#endif
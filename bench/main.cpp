@@ -0,0 +1,74 @@
+// Copyright (c) 2026- b0owl / Brennan Marx-Rennie. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to use,
+// copy, modify, and distribute the Software for NON-COMMERCIAL purposes only,
+// subject to the following conditions:
+//
+// 1. The above copyright notice and this permission notice shall be included
+//    in all copies or substantial portions of the Software.
+// 2. The Software may not be used for commercial purposes without prior
+//    written permission from the copyright holder.
+// 3. Commercial use includes, but is not limited to, selling the Software,
+//    using it in a commercial product, or using it to provide commercial services.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+
+// Runs every suite and writes the results as JSON.
+//   Bench [--out results.json] [--filter substring]
+
+#include "bench.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+std::vector<BenchResult> bench_results;
+const char* bench_filter = nullptr;
+
+bool bench_selected(const char* name) {
+    return !bench_filter || strstr(name, bench_filter) != nullptr;
+}
+
+void bench_record(const char* name, long long iterations, int ops_per_call, std::vector<double>& samples_ns) {
+    std::sort(samples_ns.begin(), samples_ns.end());
+    double ops = (double)iterations * ops_per_call;
+    BenchResult r = { name, iterations, ops_per_call,
+                      samples_ns[samples_ns.size() / 2] / ops, samples_ns[0] / ops };
+    bench_results.push_back(r);
+    printf("%-44s %12.1f ns/op  (min %.1f)\n", name, r.ns_per_op, r.min_ns_per_op);
+    fflush(stdout);
+}
+
+bool bench_write_json(const char* path) {
+    FILE* f = fopen(path, "w");
+    if (!f) return false;
+    fprintf(f, "{\n  \"version\": 1,\n  \"samples\": %d,\n  \"results\": [\n", BENCH_SAMPLES);
+    for (size_t i = 0; i < bench_results.size(); i++) {
+        const BenchResult& r = bench_results[i];
+        fprintf(f, "    {\"name\": \"%s\", \"ns_per_op\": %.3f, \"min_ns_per_op\": %.3f, "
+                   "\"iterations\": %lld, \"ops_per_call\": %d}%s\n",
+                r.name.c_str(), r.ns_per_op, r.min_ns_per_op, r.iterations, r.ops_per_call,
+                i + 1 < bench_results.size() ? "," : "");
+    }
+    fprintf(f, "  ]\n}\n");
+    return fclose(f) == 0;
+}
+
+int main(int argc, char** argv) {
+    const char* out = "bench_results.json";
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--out") == 0 && i + 1 < argc) out = argv[++i];
+        else if (strcmp(argv[i], "--filter") == 0 && i + 1 < argc) bench_filter = argv[++i];
+        else { fprintf(stderr, "usage: %s [--out results.json] [--filter substring]\n", argv[0]); return 2; }
+    }
+
+    bench_allocator();
+    bench_collisions();
+    bench_rendering();
+
+    if (!bench_write_json(out)) { fprintf(stderr, "can't write %s\n", out); return 1; }
+    printf("%zu results written to %s\n", bench_results.size(), out);
+    return 0;
+}
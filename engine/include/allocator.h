@@ -20,6 +20,12 @@
 #ifndef ALLOCATOR_H
 #define ALLOCATOR_H
 
+#include <cstddef>
+#include <new>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
 #include <GLFW/glfw3.h>
 #ifdef __APPLE__
   #include <OpenGL/gl.h>
@@ -41,6 +47,79 @@ struct DrawData {
     float width, height;
 };
 
+// Pooled DrawData storage
+// Objects live in fixed-size chunks and never move, so pointers to them can
+// be stored in an Allocator like any other DrawData*. create and destroy are
+// O(1) and only reach the heap when every chunk is full; destroyed slots are
+// reused first. createobj allocates from draw_pool_default().
+//
+// Chunks are aligned to their own size, so the chunk holding an object is
+// found by masking its address.
+static const int DRAW_POOL_CHUNK = 384;
+
+struct alignas(32768) DrawPoolChunk {
+    DrawData items[DRAW_POOL_CHUNK];  // first, so items[0] sits at the chunk's address
+    unsigned char live[DRAW_POOL_CHUNK];
+    int used;  // slots handed out at least once; the rest were never touched
+};
+static_assert(sizeof(DrawPoolChunk) == 32768, "DrawPoolChunk must fill exactly one alignment unit");
+
+// Position, color and size of a pool's live objects as separate arrays, in
+// pool order, for loops that only read a few fields (see DrawPool::soa).
+struct DrawSoA {
+    std::vector<float> x, y;
+    std::vector<float> r, g, b;
+    std::vector<float> width, height;
+    std::vector<DrawData*> objects;  // objects[i] is the DrawData behind index i
+    int count = 0;
+};
+
+class DrawPool {
+public:
+    DrawPool();
+    ~DrawPool();
+    DrawPool(const DrawPool&) = delete;
+    DrawPool& operator=(const DrawPool&) = delete;
+
+    DrawData* create(const DrawData& data);
+    DrawData* create(const float* vertex_c, int vertex_count, float X, float Y,
+                     float R, float G, float B);
+    void destroy(DrawData* data);
+    void clear();
+    void reserve(int count);
+
+    bool owns(const DrawData* data) const;
+    int size() const { return m_live; }
+    int capacity() const { return (int)m_chunks.size() * DRAW_POOL_CHUNK; }
+
+    // Visits every live object in pool order, chunk by chunk.
+    template<typename Fn>
+    void for_each(Fn fn) {
+        for (DrawPoolChunk* chunk : m_chunks) {
+            for (int i = 0; i < chunk->used; i++) {
+                if (chunk->live[i]) fn(chunk->items[i]);
+            }
+        }
+    }
+
+    void soa(DrawSoA& out) const;
+    int collect(std::vector<void*>& out) const;  // pointers for draw_struct
+
+private:
+    std::vector<DrawPoolChunk*> m_chunks;  // in allocation order
+    std::vector<DrawPoolChunk*> m_sorted;  // by address, for owns
+    DrawData* m_free;                      // list threaded through destroyed slots
+    int m_bump;                            // chunk untouched slots come from
+    int m_live;
+};
+
+DrawPool& draw_pool_default();
+// Frees a DrawData from createobj or any DrawPool, returning it to the pool
+// that owns it, or deletes it if it came from new. nullptr is ignored.
+void release_draw_data(DrawData* data);
+
+struct InstancedGroups;  // retained GPU state for draw_struct, see instanced_draw.cpp
+
 class Allocator {
 public:
     void **ptr;
@@ -48,23 +127,181 @@ public:
 
 private:
     int m_next_index;
+    InstancedGroups* m_instanced;
 
 public:
     Allocator();
     void create_pointers(int size);
 
+    // Grows the table when it is full; pointers into ptr taken before that
+    // are invalidated.
     template<typename T>
     void store_ptr(T* value) {
-        if (m_next_index >= 0 && m_next_index < m_pointers) {
-            ptr[m_next_index] = value;
-            m_next_index++;
-        }
+        if (m_next_index >= m_pointers) grow_pointers(m_pointers > 0 ? m_pointers * 2 : 16);
+        ptr[m_next_index] = value;
+        m_next_index++;
     }
 
     void reset_index() { m_next_index = 0; }
 
     void draw_struct(void** ptr, int count);
     ~Allocator();
+
+private:
+    void grow_pointers(int size);
+};
+
+// Per-frame scratch memory
+// A bump arena for objects that only live for a frame or two: allocation is
+// a pointer increment and end_frame releases everything at once. There are
+// two arenas used on alternate frames, so anything allocated in frame N stays
+// valid until the end_frame that finishes frame N+1.
+//
+// Only trivially destructible types can be created here; nothing is ever
+// destroyed. An arena that overflows borrows from the heap for the rest of
+// that frame and grows to fit the next time it is reused, so a steady
+// workload stops touching the heap after a couple of frames.
+//
+// ptr/store_ptr work like Allocator's and are double buffered the same way,
+// but stored objects are not freed. GL thread only.
+struct FrameArena {
+    unsigned char* base = nullptr;
+    size_t size = 0;
+    size_t used = 0;
+    size_t overflow_bytes = 0;      // what didn't fit, added to size on reset
+    std::vector<void*> overflow;    // heap blocks handed out after base filled
+};
+
+class FrameAllocator {
+public:
+    void **ptr;        // this frame's pointers
+    int m_pointers;
+    void **prev;       // last frame's pointers, valid until the next end_frame
+    int m_prev_count;
+
+private:
+    int m_next_index;
+    int m_current;     // arena index used this frame
+    FrameArena m_arenas[2];
+    Allocator m_drawer;  // retained instancing state for draw_struct
+
+public:
+    explicit FrameAllocator(size_t arena_bytes = 1 << 20);
+    ~FrameAllocator();
+    FrameAllocator(const FrameAllocator&) = delete;
+    FrameAllocator& operator=(const FrameAllocator&) = delete;
+
+    void create_pointers(int size);
+
+    // Grows the pointer table when it is full; pointers into ptr taken
+    // before that are invalidated.
+    template<typename T>
+    void store_ptr(T* value) {
+        if (m_next_index >= m_pointers) grow_pointers(m_pointers > 0 ? m_pointers * 2 : 16);
+        ptr[m_next_index] = value;
+        m_next_index++;
+    }
+    int count() const { return m_next_index; }
+
+    void* alloc(size_t bytes, size_t align = alignof(std::max_align_t));
+
+    template<typename T, typename... Args>
+    T* create(Args&&... args) {
+        static_assert(std::is_trivially_destructible<T>::value,
+                      "FrameAllocator never runs destructors");
+        return new (alloc(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+    }
+
+    template<typename T>
+    T* create_array(int count) {
+        static_assert(std::is_trivially_destructible<T>::value,
+                      "FrameAllocator never runs destructors");
+        T* items = (T*)alloc(sizeof(T) * (size_t)count, alignof(T));
+        for (int i = 0; i < count; i++) new (items + i) T();
+        return items;
+    }
+
+    DrawData* createobj(const float* vertex_c, int vertex_count, float X, float Y,
+                        float R, float G, float B);
+    const char* copy_string(const char* text, size_t length);
+    const char* copy_string(const std::string& text) { return copy_string(text.data(), text.size()); }
+
+    void end_frame();
+    size_t used() const { return m_arenas[m_current].used; }
+    size_t capacity() const { return m_arenas[m_current].size; }
+
+    void draw_struct(void** ptr, int count) { m_drawer.draw_struct(ptr, count); }
+
+private:
+    void grow_pointers(int size);
+};
+
+// Ended by glCleanup every frame.
+FrameAllocator& frame_allocator_default();
+
+// Long-lived objects with handles
+// A slot map: store_ptr returns a handle that stays valid until that object
+// is erased, however the storage grows or other objects come and go. Insert
+// and erase are O(1) and reuse freed slots. Live objects are kept packed at
+// the front of ptr (m_pointers of them, no nulls), so ptr/m_pointers can go
+// straight to draw_struct or the collision helpers; erase moves the last
+// object into the hole, so iterate backwards when erasing as you go.
+//
+// Each slot has a generation that erase bumps, so a handle to an erased
+// object is rejected instead of finding whatever reused its slot. Stored
+// objects are owned like Allocator's: erase, clear and the destructor free
+// them.
+struct StaticHandle {
+    unsigned int index;
+    unsigned int generation;  // never 0 for a live object, so StaticHandle{} is always invalid
+};
+
+class StaticAllocator {
+public:
+    void **ptr;        // live objects, packed
+    int m_pointers;    // how many
+
+private:
+    struct Slot {
+        unsigned int generation;
+        int dense;     // index into ptr while live, next free slot while free
+    };
+    std::vector<Slot> m_slots;
+    std::vector<unsigned int> m_dense_slots;  // slot of each ptr entry
+    int m_capacity;
+    int m_free_slot;
+    Allocator m_drawer;  // retained instancing state for draw_struct
+
+public:
+    StaticAllocator();
+    ~StaticAllocator();
+    StaticAllocator(const StaticAllocator&) = delete;
+    StaticAllocator& operator=(const StaticAllocator&) = delete;
+
+    // Frees everything stored and reserves room for size objects. Storing
+    // more than that still works, it just grows.
+    void create_pointers(int size);
+    void reserve(int size);
+
+    template<typename T>
+    StaticHandle store_ptr(T* value) { return insert(value); }
+
+    DrawData* get(StaticHandle handle) const;
+    bool valid(StaticHandle handle) const;
+    StaticHandle handle_at(int index) const;  // handle of ptr[index]
+    bool erase(StaticHandle handle);
+    void clear();
+    int size() const { return m_pointers; }
+
+    // For code written against Allocator: forgets every handle WITHOUT
+    // freeing the objects, which become the caller's again.
+    void reset_index();
+
+    void draw_struct(void** ptr, int count) { m_drawer.draw_struct(ptr, count); }
+
+private:
+    StaticHandle insert(void* value);
+    void drop_all(bool release);
 };
 
 #endif
@@ -0,0 +1,47 @@
+// Copyright (c) 2026- b0owl / Brennan Marx-Rennie. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to use,
+// copy, modify, and distribute the Software for NON-COMMERCIAL purposes only,
+// subject to the following conditions:
+//
+// 1. The above copyright notice and this permission notice shall be included
+//    in all copies or substantial portions of the Software.
+// 2. The Software may not be used for commercial purposes without prior
+//    written permission from the copyright holder.
+// 3. Commercial use includes, but is not limited to, selling the Software,
+//    using it in a commercial product, or using it to provide commercial services.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+
+#ifndef ASSETS_H
+#define ASSETS_H
+
+// Asynchronous asset loading
+// Files are decoded (images) or baked (fonts) on worker threads. The finished
+// pixel buffers are uploaded on the GL thread by process_asset_uploads, which
+// glCleanup calls every frame within a small time budget. Once an asset is
+// ready, the regular load_image / load_spritesheet / draw_text calls hit the
+// cache and return instantly.
+
+enum class AssetState { Pending, Ready, Failed };
+
+struct AssetHandle {
+    int id;
+};
+
+AssetHandle load_texture_async(const char* filepath);
+AssetHandle load_font_async(const char* font_path);
+
+AssetState asset_state(AssetHandle handle);
+bool asset_ready(AssetHandle handle);
+int assets_pending();
+
+void set_asset_workers(int count);
+void set_asset_upload_budget(double ms);
+int process_asset_uploads(double budget_ms = -1.0);
+void wait_for_assets();
+
+#endif
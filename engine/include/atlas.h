@@ -0,0 +1,62 @@
+// Copyright (c) 2026- b0owl / Brennan Marx-Rennie. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to use,
+// copy, modify, and distribute the Software for NON-COMMERCIAL purposes only,
+// subject to the following conditions:
+//
+// 1. The above copyright notice and this permission notice shall be included
+//    in all copies or substantial portions of the Software.
+// 2. The Software may not be used for commercial purposes without prior
+//    written permission from the copyright holder.
+// 3. Commercial use includes, but is not limited to, selling the Software,
+//    using it in a commercial product, or using it to provide commercial services.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+
+#ifndef ATLAS_H
+#define ATLAS_H
+
+#include <vector>
+#include "rendering.h"
+
+// Texture atlas
+// Packs many small images into a few large RGBA pages so that sprites and
+// icons from different files share a texture and batch into one draw call.
+
+// A packed image: the page texture it lives on and its UV sub-rectangle.
+// u0/v0 is the top-left texel, u1/v1 the bottom-right (image orientation).
+struct AtlasRegion {
+    unsigned int tex;
+    int w, h;
+    float u0, v0, u1, v1;
+};
+
+// Skyline bottom-left rectangle packer. Pure CPU bookkeeping, no GL.
+class SkylinePacker {
+public:
+    SkylinePacker();
+    void reset(int width, int height);
+    bool pack(int w, int h, int& out_x, int& out_y);
+    float occupancy() const;
+
+private:
+    struct Node { int x, y, w; };
+    bool fits(int index, int w, int h, int& out_y) const;
+
+    std::vector<Node> m_skyline;
+    int m_width, m_height;
+    long long m_used_area;
+};
+
+void atlas_set_page_size(int size);
+int atlas_page_count();
+void atlas_clear();
+
+AtlasRegion atlas_add_image(const char* filepath);
+Image load_image_atlas(const char* filepath);
+SpriteSheet load_spritesheet_atlas(const char* filepath, int cols, int rows);
+
+#endif
@@ -0,0 +1,49 @@
+// Copyright (c) 2026- b0owl / Brennan Marx-Rennie. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to use,
+// copy, modify, and distribute the Software for NON-COMMERCIAL purposes only,
+// subject to the following conditions:
+//
+// 1. The above copyright notice and this permission notice shall be included
+//    in all copies or substantial portions of the Software.
+// 2. The Software may not be used for commercial purposes without prior
+//    written permission from the copyright holder.
+// 3. Commercial use includes, but is not limited to, selling the Software,
+//    using it in a commercial product, or using it to provide commercial services.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+
+#ifndef BATCH_H
+#define BATCH_H
+
+// Sprite batching
+// draw_sprite and draw_image don't draw immediately; they append a quad to the
+// batch. Quads are grouped into runs that share a texture, and each run is a
+// single glDrawArrays when the batch is flushed. glCleanup flushes every frame,
+// and the immediate-mode draw paths flush before drawing so call order is kept.
+// A run also breaks when the shader changes.
+
+// Fragment program a run is drawn with.
+enum BatchShader {
+    BATCH_SHADER_DEFAULT = 0,  // texture * vertex color
+    BATCH_SHADER_SDF     = 1,  // signed distance field glyphs (FontMode::SDF)
+};
+
+struct BatchVertex {
+    float x, y;
+    float u, v;
+    float r, g, b, a;
+};
+
+void batch_begin();
+void batch_submit(unsigned int tex, float x0, float y0, float x1, float y1,
+                  float u0, float v0, float u1, float v1,
+                  float r = 1.0f, float g = 1.0f, float b = 1.0f, float a = 1.0f,
+                  int shader = BATCH_SHADER_DEFAULT);
+void batch_flush();
+int batch_pending_quads();
+
+#endif
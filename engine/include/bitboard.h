@@ -0,0 +1,163 @@
+// Copyright (c) 2026- b0owl / Brennan Marx-Rennie. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to use,
+// copy, modify, and distribute the Software for NON-COMMERCIAL purposes only,
+// subject to the following conditions:
+//
+// 1. The above copyright notice and this permission notice shall be included
+//    in all copies or substantial portions of the Software.
+// 2. The Software may not be used for commercial purposes without prior
+//    written permission from the copyright holder.
+// 3. Commercial use includes, but is not limited to, selling the Software,
+//    using it in a commercial product, or using it to provide commercial services.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+
+#ifndef BITBOARD_H
+#define BITBOARD_H
+
+#include "allocator.h"
+#include <stdint.h>
+#include <cmath>
+
+// Grid boards
+// For pieces that live on a fixed grid, like falling blocks. A board is one
+// 64-bit word per row, bit x set when column x is filled, row 0 at the
+// bottom. A piece is a few row masks; placed at (x, y) its rows are shifted
+// left by x and lined up with board rows y, y + 1, ... so a collision test
+// is one AND per piece row, and lines are full when a row equals the full
+// mask. Everything is plain values, cheap to copy for AI lookahead.
+//
+// The board is walled on every side: cells left of column 0, right of the
+// last column, below row 0 or above the top row all count as filled. Give
+// the board enough rows for pieces to spawn in.
+static const int BITBOARD_MAX_ROWS = 64;
+static const int PIECE_MAX_ROWS = 4;
+
+struct Bitboard {
+    int width;      // 1..64 columns
+    int height;     // 1..BITBOARD_MAX_ROWS rows
+    uint64_t full;  // the bits of a complete row
+    uint64_t rows[BITBOARD_MAX_ROWS];
+};
+
+struct PieceMask {
+    int width, height;               // bounding box, in cells
+    uint64_t rows[PIECE_MAX_ROWS];   // bottom row first, lowest column at bit 0
+};
+
+inline Bitboard bitboard_make(int width, int height) {
+    Bitboard board = {};
+    board.width = width;
+    board.height = height;
+    board.full = width >= 64 ? ~(uint64_t)0 : (((uint64_t)1 << width) - 1);
+    return board;
+}
+
+inline bool bitboard_get(const Bitboard& board, int x, int y) {
+    if (x < 0 || x >= board.width || y < 0 || y >= board.height) return true;  // walls
+    return (board.rows[y] >> x) & 1;
+}
+
+inline void bitboard_set(Bitboard& board, int x, int y, bool filled = true) {
+    if (x < 0 || x >= board.width || y < 0 || y >= board.height) return;
+    if (filled) board.rows[y] |= (uint64_t)1 << x;
+    else board.rows[y] &= ~((uint64_t)1 << x);
+}
+
+// The piece covering the given cells, moved so its lowest cell is in row 0
+// and its leftmost in column 0; out_x/out_y (optional) receive that offset.
+// Cells beyond PIECE_MAX_ROWS rows or 64 columns are dropped.
+inline PieceMask piece_from_cells(const int (*cells)[2], int count, int* out_x = nullptr, int* out_y = nullptr) {
+    PieceMask piece = {};
+    if (count <= 0) return piece;
+    int min_x = cells[0][0], min_y = cells[0][1], max_x = min_x, max_y = min_y;
+    for (int i = 1; i < count; i++) {
+        min_x = cells[i][0] < min_x ? cells[i][0] : min_x;
+        min_y = cells[i][1] < min_y ? cells[i][1] : min_y;
+        max_x = cells[i][0] > max_x ? cells[i][0] : max_x;
+        max_y = cells[i][1] > max_y ? cells[i][1] : max_y;
+    }
+    piece.width = max_x - min_x + 1;
+    piece.height = max_y - min_y + 1 < PIECE_MAX_ROWS ? max_y - min_y + 1 : PIECE_MAX_ROWS;
+    for (int i = 0; i < count; i++) {
+        int x = cells[i][0] - min_x, y = cells[i][1] - min_y;
+        if (y < PIECE_MAX_ROWS && x < 64) piece.rows[y] |= (uint64_t)1 << x;
+    }
+    if (out_x) *out_x = min_x;
+    if (out_y) *out_y = min_y;
+    return piece;
+}
+
+// Grid cell of a block whose lower-left corner is at its DrawData x, y, for
+// a grid with cell (0, 0) at origin_x, origin_y.
+inline void grid_cell(const DrawData* block, float origin_x, float origin_y, float cell_size, int& x, int& y) {
+    x = (int)std::floor((block->x - origin_x) / cell_size + 0.5f);
+    y = (int)std::floor((block->y - origin_y) / cell_size + 0.5f);
+}
+
+// The piece made of the given blocks (e.g. the four a piece function
+// returns), with its grid position in x, y.
+inline PieceMask piece_from_blocks(DrawData* const* blocks, int count, float origin_x, float origin_y,
+                                   float cell_size, int& x, int& y) {
+    int cells[64][2];
+    int n = count < 64 ? count : 64;
+    for (int i = 0; i < n; i++) grid_cell(blocks[i], origin_x, origin_y, cell_size, cells[i][0], cells[i][1]);
+    return piece_from_cells(cells, n, &x, &y);
+}
+
+// The piece turned 90 degrees clockwise, moved back to row 0 / column 0.
+inline PieceMask piece_rotate_cw(const PieceMask& piece) {
+    int cells[PIECE_MAX_ROWS * 64][2];
+    int n = 0;
+    for (int y = 0; y < piece.height; y++)
+        for (int x = 0; x < piece.width; x++)
+            if ((piece.rows[y] >> x) & 1) { cells[n][0] = y; cells[n][1] = -x; n++; }
+    return piece_from_cells(cells, n);
+}
+
+// True if the piece at (x, y) overlaps a filled cell or a wall.
+inline bool bitboard_collides(const Bitboard& board, const PieceMask& piece, int x, int y) {
+    if (x < 0 || x + piece.width > board.width || y < 0 || y + piece.height > board.height) return true;
+    for (int r = 0; r < piece.height; r++)
+        if ((piece.rows[r] << x) & board.rows[y + r]) return true;
+    return false;
+}
+
+inline void bitboard_place(Bitboard& board, const PieceMask& piece, int x, int y) {
+    if (x < 0 || x >= 64) return;
+    for (int r = 0; r < piece.height; r++)
+        if (y + r >= 0 && y + r < board.height) board.rows[y + r] |= (piece.rows[r] << x) & board.full;
+}
+
+// How many rows the piece at (x, y) can fall before it lands; -1 if it
+// already collides there.
+inline int bitboard_drop_distance(const Bitboard& board, const PieceMask& piece, int x, int y) {
+    if (bitboard_collides(board, piece, x, y)) return -1;
+    int d = 0;
+    while (y - d - 1 >= 0 && !bitboard_collides(board, piece, x, y - d - 1)) d++;
+    return d;
+}
+
+// Bit r is set when row r is full.
+inline uint64_t bitboard_full_rows(const Bitboard& board) {
+    uint64_t mask = 0;
+    for (int r = 0; r < board.height; r++)
+        if (board.rows[r] == board.full) mask |= (uint64_t)1 << r;
+    return mask;
+}
+
+// Removes full rows, moving the rows above them down. Returns how many.
+inline int bitboard_clear_rows(Bitboard& board) {
+    int write = 0;
+    for (int r = 0; r < board.height; r++)
+        if (board.rows[r] != board.full) board.rows[write++] = board.rows[r];
+    int cleared = board.height - write;
+    for (int r = write; r < board.height; r++) board.rows[r] = 0;
+    return cleared;
+}
+
+#endif
@@ -27,9 +27,19 @@
 #endif
 #include "allocator.h"
 #include "window.h"
+#include "loop.h"
 #include "rendering.h"
+#include "batch.h"
+#include "atlas.h"
+#include "assets.h"
+#include "residency.h"
+#include "pack.h"
+#include "gl_state.h"
+#include "render_queue.h"
+#include "profiler.h"
 #include "keyboard.h"
 #include "mouse.h"
 #include "collisions.h"
+#include "bitboard.h"
 
 #endif
@@ -20,8 +20,13 @@
 #ifndef COLLISIONS_H
 #define COLLISIONS_H
 #include "allocator.h"
+#include <stdint.h>
+#include <unordered_set>
 #include <vector>
 
+// The templates below copy every object in the allocator on each call, so
+// they are O(n) per query. For many objects use SpatialHash.
+
 template<typename AllocatorType>
 std::vector<int> return_dims(AllocatorType& allocator, std::vector<DrawData>& entidvec) { 
     entidvec.reserve(allocator.m_pointers);
@@ -83,4 +88,225 @@ bool is_colliding(AllocatorType& allocator, std::vector<DrawData>& entidvec1, st
     return false;
 }
 
-#endif
\ No newline at end of file
+// Broadphase
+// A uniform grid over the bounds (x, y, width, height) of a set of DrawData,
+// rebuilt whenever the objects move. build is O(n); pairs and query only
+// look at the cells involved. All storage is kept between calls, so once the
+// buffers have grown to fit, a build/pairs/query cycle doesn't allocate.
+//
+// Boxes overlap when they overlap or touch, like is_colliding, so objects
+// with zero width and height are points. Objects are identified by their
+// index in the ptr array given to build; nullptr entries are skipped.
+struct CollisionPair {
+    int a, b;  // a < b
+};
+
+class SpatialHash {
+public:
+    // cell_size <= 0 picks twice the average object size on every build.
+    explicit SpatialHash(float cell_size = 64.0f);
+
+    void set_cell_size(float cell_size) { m_cell_size = cell_size; }
+    float cell_size() const { return m_cell; }
+
+    void build(void** ptr, int count);
+    template<typename AllocatorType>
+    void build(AllocatorType& allocator) { build(allocator.ptr, allocator.m_pointers); }
+
+    // Every overlapping pair, each reported once. The returned vector is
+    // reused by the next call.
+    const std::vector<CollisionPair>& pairs();
+    // Indices of the objects overlapping the box, each once. Replaces out's
+    // contents and returns the count.
+    int query(float x, float y, float width, float height, std::vector<int>& out) const;
+
+    int size() const { return (int)m_index.size(); }
+
+private:
+    struct Entry {
+        int cx, cy;
+        int object;  // index into m_index / the bounds arrays
+    };
+
+    void cell_range(float x0, float y0, float x1, float y1, int& cx0, int& cy0, int& cx1, int& cy1) const;
+    unsigned int bucket(int cx, int cy) const;
+    bool overlaps(int a, int b) const;
+
+    float m_cell_size;
+    float m_cell;      // size used by the last build
+    float m_inv_cell;
+    std::vector<int> m_index;              // ptr index of each object
+    std::vector<float> m_x0, m_y0, m_x1, m_y1;
+    std::vector<int> m_cx0, m_cy0, m_cx1, m_cy1;
+    std::vector<int> m_large;              // objects covering too many cells to insert
+    std::vector<unsigned char> m_is_large;
+    std::vector<unsigned int> m_bucket_start;  // entries of bucket i: [start[i], start[i + 1])
+    std::vector<Entry> m_entries;
+    unsigned int m_bucket_mask;
+    std::vector<CollisionPair> m_pairs;
+};
+
+// Incremental broadphase
+// Sweep and prune: each axis keeps its box endpoints sorted, and update
+// re-sorts them with insertion sort. When objects move a little between
+// frames the lists are already nearly sorted, so an update costs about O(n)
+// plus the pairs that changed. Instead of a full pair list it reports which
+// pairs started and stopped overlapping since the last update; pairs() has
+// the current set.
+//
+// Objects are proxies: add() tracks a DrawData, whose bounds (x, y, width,
+// height) are re-read on every update, and add_box() tracks a box you move
+// yourself with move_box(). The DrawData must stay at the same address while
+// tracked, which pooled objects do. Touching counts as overlapping.
+class SweepAndPrune {
+public:
+    SweepAndPrune();
+
+    int add(const DrawData* object);
+    int add_box(float x, float y, float width, float height);
+    void move_box(int id, float x, float y, float width, float height);
+    // The proxy's pairs are reported as ended by the next update, after
+    // which its id can be reused.
+    void remove(int id);
+
+    void update();
+
+    // Valid until the next update. Pairs hold proxy ids, a < b.
+    const std::vector<CollisionPair>& began() const { return m_began; }
+    const std::vector<CollisionPair>& ended() const { return m_ended; }
+    void pairs(std::vector<CollisionPair>& out) const;
+    bool overlapping(int a, int b) const;
+
+    const DrawData* object(int id) const { return m_proxies[id].object; }
+    int size() const { return m_live; }
+
+private:
+    struct Proxy {
+        float min[2], max[2];
+        const DrawData* object;
+        bool alive;
+        bool added;     // endpoints not in the lists yet
+        bool removed;   // endpoints still in the lists, dropped by the next update
+    };
+    struct Endpoint {
+        float value;
+        int packed;     // id << 1 | is_max
+    };
+
+    void set_bounds(Proxy& proxy, float x, float y, float width, float height);
+    void sort_axis(int axis);
+    void pair_changed(int a, int b, bool overlap);
+
+    std::vector<Proxy> m_proxies;
+    std::vector<int> m_free_ids;
+    std::vector<Endpoint> m_axis[2];
+    std::unordered_set<uint64_t> m_pairs;
+    std::unordered_set<uint64_t> m_touched;           // pairs changed during this update
+    std::vector<std::pair<uint64_t, bool>> m_before;  // ...and whether they overlapped before it
+    std::vector<CollisionPair> m_began, m_ended;
+    bool m_has_removed;
+    int m_live;
+};
+
+// Spatial queries
+// A dynamic bounding volume tree for finding what sits under a point, along
+// a ray or inside a rectangle in O(log n). Each proxy is stored with a
+// slightly larger "fat" box, so small moves only update the proxy's own
+// bounds and the tree is restructured only when it leaves its fat box.
+// Inserts and removals rotate nodes to keep sibling boxes from overlapping.
+//
+// Proxies track a DrawData (re-read by update) or a plain box moved with
+// move_box; either can carry a user pointer. Queries test the exact bounds
+// and count touching edges as hits. Queries share a traversal stack, so one
+// tree must not be queried from several threads at once.
+struct RayHit {
+    int id;        // -1 if nothing was hit
+    float t;       // hit point is origin + t * direction
+    float x, y;
+};
+
+class AabbTree {
+public:
+    // Fat boxes are grown by margin times the box's larger side on every edge.
+    explicit AabbTree(float margin = 0.1f);
+
+    int add(const DrawData* object, void* user = nullptr);
+    int add_box(float x, float y, float width, float height, void* user = nullptr);
+    // Returns true if the proxy left its fat box and was re-inserted.
+    bool move_box(int id, float x, float y, float width, float height);
+    void remove(int id);
+    // Re-reads every tracked DrawData and moves the proxies that changed.
+    void update();
+    void clear();
+
+    // Each replaces out and returns the number of proxies found.
+    int query_point(float x, float y, std::vector<int>& out) const;
+    int query_region(float x, float y, float width, float height, std::vector<int>& out) const;
+    // Nearest proxy hit by the ray within max_t (in units of direction).
+    RayHit raycast(float ox, float oy, float dx, float dy, float max_t = 1e30f) const;
+
+    const DrawData* object(int id) const { return m_nodes[id].object; }
+    void* user(int id) const { return m_nodes[id].user; }
+    int size() const { return m_leaves; }
+    int height() const { return m_root < 0 ? 0 : m_nodes[m_root].height; }
+
+private:
+    struct Node {
+        float min[2], max[2];      // fat box for leaves, union of children otherwise
+        float tight[4];            // leaves: exact min x, min y, max x, max y
+        const DrawData* object;
+        void* user;
+        int parent;                // next free node while free
+        int child1, child2;        // -1 for leaves
+        int height;                // 0 for leaves, -1 while free
+    };
+
+    int alloc_node();
+    void free_node(int id);
+    void set_tight(Node& node, float x, float y, float width, float height);
+    void fatten(Node& node);
+    void insert_leaf(int leaf);
+    void remove_leaf(int leaf);
+    void rotate(int index);
+    void refit(int index);
+
+    std::vector<Node> m_nodes;
+    int m_root;
+    int m_free;
+    int m_leaves;
+    float m_margin;
+    mutable std::vector<int> m_stack;
+};
+
+// Bulk box tests
+// Overlap tests of one box, or many, against a set of boxes stored as
+// separate min/max arrays, answered as bitmasks: bit i of a mask is set when
+// box i overlaps, 32 boxes per word, unused bits of the last word clear.
+// Runs on AVX2 when the CPU has it, SSE2 on other x86 CPUs, and plain C++
+// elsewhere; all three give exactly the same bits. Touching counts as
+// overlapping, like is_colliding.
+struct BoxSoA {
+    std::vector<float> min_x, min_y;
+    std::vector<float> max_x, max_y;
+    int count = 0;
+};
+
+enum class AabbSimd { Scalar, SSE2, AVX2 };
+
+// Box i is ptr[i]'s bounds; nullptr entries become boxes that never overlap.
+void aabb_from_objects(void** ptr, int count, BoxSoA& out);
+void aabb_from_soa(const DrawSoA& objects, BoxSoA& out);
+
+inline int aabb_mask_words(int count) { return (count + 31) / 32; }
+// mask needs aabb_mask_words(boxes.count) words. Returns how many boxes overlap.
+int aabb_overlap_mask(float min_x, float min_y, float max_x, float max_y,
+                      const BoxSoA& boxes, uint32_t* mask);
+// One mask per box of a, each aabb_mask_words(b.count) words, row after row.
+void aabb_overlap_masks(const BoxSoA& a, const BoxSoA& b, uint32_t* masks);
+
+// The fastest path this CPU supports is picked on first use. Requests for a
+// path the CPU lacks fall back to the best one it has.
+void aabb_set_simd(AabbSimd path);
+AabbSimd aabb_simd();
+
+#endif
@@ -0,0 +1,65 @@
+// Copyright (c) 2026- b0owl / Brennan Marx-Rennie. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to use,
+// copy, modify, and distribute the Software for NON-COMMERCIAL purposes only,
+// subject to the following conditions:
+//
+// 1. The above copyright notice and this permission notice shall be included
+//    in all copies or substantial portions of the Software.
+// 2. The Software may not be used for commercial purposes without prior
+//    written permission from the copyright holder.
+// 3. Commercial use includes, but is not limited to, selling the Software,
+//    using it in a commercial product, or using it to provide commercial services.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+
+#ifndef GL_STATE_H
+#define GL_STATE_H
+
+// GL state cache
+// The engine's draw paths set GL state through these wrappers instead of
+// calling GL directly. A shadow copy of the tracked state is kept, calls that
+// wouldn't change anything are skipped, and draw paths no longer undo their
+// state on exit — each one sets what it needs on entry instead.
+//
+// Tracked: glEnable/glDisable of GL_BLEND, GL_TEXTURE_2D and GL_ALPHA_TEST,
+// glBlendFunc, the GL_TEXTURE_2D binding, the bound program and vertex array
+// object, and the vertex, texcoord and color client arrays. Other caps are
+// passed straight through. On core-profile contexts the fixed-function ones
+// (GL_TEXTURE_2D, GL_ALPHA_TEST, client arrays) don't exist and are ignored.
+//
+// If you call GL yourself between engine draws, call gls_invalidate()
+// afterwards so the cache doesn't skip a call it shouldn't. glCleanup puts
+// the tracked state back to GL's defaults at the end of every frame.
+
+struct GLStateStats {
+    int changes;        // calls that reached GL
+    int skipped;        // redundant calls elided
+    int texture_binds;  // included in changes
+    int program_binds;  // included in changes
+    int draw_calls;     // also counted by the null renderer
+    int vertices;       // vertices submitted by those draw calls
+};
+
+void gls_enable(unsigned int cap);
+void gls_disable(unsigned int cap);
+void gls_blend_func(unsigned int src, unsigned int dst);
+void gls_bind_texture(unsigned int tex);
+unsigned int gls_gen_texture();
+void gls_delete_texture(unsigned int tex);
+void gls_use_program(unsigned int program);
+void gls_bind_vertex_array(unsigned int vao);
+void gls_enable_client(unsigned int array);
+void gls_disable_client(unsigned int array);
+
+void gls_count_draw(int vertices);
+
+void gls_invalidate();
+void gls_reset_defaults();
+void gls_end_frame();
+GLStateStats gls_stats();
+
+#endif
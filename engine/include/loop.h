@@ -0,0 +1,76 @@
+// Copyright (c) 2026- b0owl / Brennan Marx-Rennie. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to use,
+// copy, modify, and distribute the Software for NON-COMMERCIAL purposes only,
+// subject to the following conditions:
+//
+// 1. The above copyright notice and this permission notice shall be included
+//    in all copies or substantial portions of the Software.
+// 2. The Software may not be used for commercial purposes without prior
+//    written permission from the copyright holder.
+// 3. Commercial use includes, but is not limited to, selling the Software,
+//    using it in a commercial product, or using it to provide commercial services.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+
+#ifndef LOOP_H
+#define LOOP_H
+
+#include <GLFW/glfw3.h>
+#include <functional>
+
+// Main loop runner
+// Fixed-timestep simulation with render interpolation and a frame limiter,
+// all on double-precision time. run_loop wires them together; the pieces
+// also work on their own in a hand-written loop.
+
+// Seconds since GLFW was initialized, at full double precision
+double get_time();
+
+// Fixed timestep accumulator
+struct FixedTimestep {
+    double step;          // simulation step in seconds
+    double max_frame_dt;  // longer frames are clamped so the simulation can't spiral
+    double accumulator;   // unsimulated time carried to the next frame
+    double alpha;         // accumulator / step: how far rendering is between the last two steps
+    long long steps;      // steps run so far
+};
+
+FixedTimestep fixed_timestep(double step, double max_frame_dt = 0.25);
+int fixed_timestep_advance(FixedTimestep* ts, double frame_dt);
+
+// Frame limiter: sleeps most of the remaining frame time, then spins the rest
+struct FrameLimiter {
+    double period;  // seconds per frame, 0 = no limit
+    double next;    // deadline of the current frame
+    double spin;    // margin left for spinning; adapts to how late sleeps wake up
+};
+
+FrameLimiter frame_limiter(double target_fps);
+void frame_limiter_wait(FrameLimiter* limiter);
+
+// Loop runner
+struct LoopConfig {
+    double fixed_dt;      // simulation step, default 1/60 s
+    double max_frame_dt;  // frame time clamp, default 0.25 s
+    double target_fps;    // frame limiter target, default 0 (off; rely on vsync)
+};
+
+struct LoopFrame {
+    double time;       // seconds since run_loop started
+    double frame_dt;   // wall time of the previous frame, clamped to max_frame_dt
+    double alpha;      // interpolation factor between the last two simulation states
+    long long frame;   // frames rendered so far
+    int fb_w, fb_h;
+    float aspect;
+};
+
+LoopConfig default_loop_config();
+void run_loop(GLFWwindow* window, const LoopConfig& config,
+              const std::function<void(double dt)>& update,
+              const std::function<void(const LoopFrame& frame)>& render);
+
+#endif
@@ -0,0 +1,38 @@
+// Copyright (c) 2026- b0owl / Brennan Marx-Rennie. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to use,
+// copy, modify, and distribute the Software for NON-COMMERCIAL purposes only,
+// subject to the following conditions:
+//
+// 1. The above copyright notice and this permission notice shall be included
+//    in all copies or substantial portions of the Software.
+// 2. The Software may not be used for commercial purposes without prior
+//    written permission from the copyright holder.
+// 3. Commercial use includes, but is not limited to, selling the Software,
+//    using it in a commercial product, or using it to provide commercial services.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+
+#ifndef PACK_H
+#define PACK_H
+
+// Packed asset archives
+// tools/pack_assets turns a directory of images and fonts into one .pak file
+// of decoded pixels, baked bitmap font atlases with their glyph metrics, and
+// a hashed index (see docs/Pack.md). Mounting maps the file into memory. From
+// then on load_image, load_spritesheet, draw_text, the async loader and
+// residency reloads find those paths in the archive instead of decoding the
+// originals, and upload straight from the mapping.
+//
+// prefix is the directory the archive was built from, as the game spells it:
+// with mount_pack("assets.pak", "assets/"), load_image("assets/player.png")
+// looks up "player.png". Later mounts are searched first.
+
+bool mount_pack(const char* pack_path, const char* prefix = "");
+void unmount_pack(const char* pack_path);
+bool pack_contains(const char* path);
+
+#endif
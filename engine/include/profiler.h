@@ -0,0 +1,66 @@
+// Copyright (c) 2026- b0owl / Brennan Marx-Rennie. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to use,
+// copy, modify, and distribute the Software for NON-COMMERCIAL purposes only,
+// subject to the following conditions:
+//
+// 1. The above copyright notice and this permission notice shall be included
+//    in all copies or substantial portions of the Software.
+// 2. The Software may not be used for commercial purposes without prior
+//    written permission from the copyright holder.
+// 3. Commercial use includes, but is not limited to, selling the Software,
+//    using it in a commercial product, or using it to provide commercial services.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+
+#ifndef PROFILER_H
+#define PROFILER_H
+
+// Frame profiler
+// Scoped CPU markers, GL timer queries around the engine's draw paths and
+// per-frame counters. Nothing is recorded until profiler_enable(true); while
+// disabled a scope costs one branch. glCleanup closes each frame.
+//
+// Scope names are stored by pointer, so pass string literals (or strings
+// that outlive the profiler).
+
+struct ProfileFrame {
+    int    frame;          // frame number since the profiler was enabled
+    double cpu_ms;         // glCleanup to glCleanup
+    double gpu_ms;         // GPU time of the top-level GPU scopes of frame gpu_frame
+    int    gpu_frame;      // GPU results arrive a few frames late; -1 until the first one
+    int    draw_calls;
+    int    texture_binds;
+    int    state_changes;  // every GL state call that wasn't skipped
+    int    vertices;
+    int    glyphs;         // glyph quads built by draw_text / build_text_mesh
+    int    cache_hits;     // texture, atlas, font and glyph cache lookups
+    int    cache_misses;
+};
+
+void profiler_enable(bool enabled);
+bool profiler_enabled();
+void profiler_set_gpu_timing(bool enabled);
+
+void profile_begin(const char* name, bool gpu = false);
+void profile_end();
+
+// RAII scope: PROFILE_SCOPE("update") profiles until the end of the block.
+struct ProfileScope {
+    ProfileScope(const char* name, bool gpu = false) { profile_begin(name, gpu); }
+    ~ProfileScope() { profile_end(); }
+};
+#define PROFILE_CONCAT_(a, b) a##b
+#define PROFILE_CONCAT(a, b)  PROFILE_CONCAT_(a, b)
+#define PROFILE_SCOPE(name)   ProfileScope PROFILE_CONCAT(profile_scope_, __LINE__)(name)
+
+void profiler_end_frame();
+ProfileFrame profiler_last_frame();
+
+bool profiler_write_trace(const char* path);
+void profiler_clear();
+
+#endif
@@ -0,0 +1,55 @@
+// Copyright (c) 2026- b0owl / Brennan Marx-Rennie. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to use,
+// copy, modify, and distribute the Software for NON-COMMERCIAL purposes only,
+// subject to the following conditions:
+//
+// 1. The above copyright notice and this permission notice shall be included
+//    in all copies or substantial portions of the Software.
+// 2. The Software may not be used for commercial purposes without prior
+//    written permission from the copyright holder.
+// 3. Commercial use includes, but is not limited to, selling the Software,
+//    using it in a commercial product, or using it to provide commercial services.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+
+#ifndef RENDER_QUEUE_H
+#define RENDER_QUEUE_H
+
+// Render queue
+// Off by default: draw_* calls run (or batch) in call order. With the queue
+// on, draw_sprite, draw_image, draw_text, draw_text_mesh and draw_struct only
+// record a command tagged with the current layer, depth and blend mode. The
+// queue is sorted once per frame by
+//
+//     layer | depth | blend | shader | texture
+//
+// and replayed from glCleanup or render_queue_flush. Commands with equal keys
+// keep their call order, so with the default depth everything within a layer
+// is grouped by texture and otherwise drawn as called.
+//
+// Recorded text meshes and draw_struct arrays are drawn at flush time, so they
+// must stay alive (and unchanged, if you want the recorded look) until then.
+
+enum class BlendMode {
+    Alpha,          // src * a + dst * (1 - a), the default
+    Additive,       // src * a + dst
+    Premultiplied,  // src + dst * (1 - a), for textures loaded with premultiply
+};
+
+void render_set_layer(int layer);     // -128..127, higher draws on top, default 0
+void render_set_depth(float depth);   // 0..1 within a layer, higher draws on top, default 0
+void render_set_blend(BlendMode mode);
+int render_get_layer();
+float render_get_depth();
+BlendMode render_get_blend();
+
+void render_queue_enable(bool enabled);
+bool render_queue_enabled();
+void render_queue_flush();
+int render_queue_size();
+
+#endif
@@ -2,23 +2,100 @@
 #define RENDERING_H
 
 #include "allocator.h"
+#include <string>
+#include <vector>
 
+// Allocated from draw_pool_default(): free with release_draw_data, never delete.
 DrawData* createobj(const float* vertex_c, int vertex_count, float X, float Y,
                     float R, float G, float B);
 
+// Images (cached by path; see load_image)
+// u0/v0..u1/v1 is the sub-rectangle of tex holding the image; it only differs
+// from the full texture for images packed into an atlas (see atlas.h).
+struct Image {
+    unsigned int tex;
+    int img_w, img_h;
+    float u0 = 0.0f, v0 = 0.0f, u1 = 1.0f, v1 = 1.0f;
+};
+
+// Upload options for images and spritesheets (see docs/Rendering.md). A path
+// keeps the options it was first loaded with until it's unloaded.
+enum class TextureFormat {
+    Auto,      // RGBA8 or RGB8, as decoded
+    RGB565,    // 16 bits per texel, alpha dropped
+    RGBA4444,  // 16 bits per texel, 4-bit alpha
+};
+
+struct TextureOptions {
+    bool mipmaps = false;      // trilinear filtering when drawn smaller than the file
+    bool premultiply = false;  // color * alpha on upload; draw with BlendMode::Premultiplied
+    TextureFormat format = TextureFormat::Auto;
+};
+
+void set_texture_options(const TextureOptions& options);  // for loads without options
+TextureOptions get_texture_options();
+
+Image load_image(const char* filepath);
+Image load_image(const char* filepath, const TextureOptions& options);
+void unload_image(const char* filepath);
+void draw_image(Image image, float x, float y, float w, float h, float* out_corrected_w = nullptr);
 unsigned int draw_image(const char* filepath, float x, float y, float w, float h, float* out_corrected_w = nullptr);
+
+// Which GL path the draw_* functions take. Auto picks Core on core-profile
+// contexts (apply_optimized_2d_settings) and Legacy otherwise. Core uses
+// GLSL 3.30 shaders, VAOs and VBOs, and needs a GL 3.3 context; it can also
+// be forced on a compatibility context. Null makes no GL calls at all and
+// only counts draws (gls_stats); headless windows without a context use it.
+// See docs/Rendering.md.
+enum class RenderBackend { Auto, Legacy, Core, Null };
+
+void set_render_backend(RenderBackend backend);
+RenderBackend get_render_backend();
+
+// How draw_text, get_text_width, get_text_cap_height and build_text_mesh
+// rasterize glyphs. Bitmap bakes ASCII once per font at a fixed size; SDF
+// keeps signed distance fields in one shared atlas page, takes UTF-8, and
+// stays sharp at any size (see docs/Rendering.md).
+enum class FontMode { Bitmap, SDF };
+
+void set_font_mode(FontMode mode);
+FontMode get_font_mode();
+
 void draw_text(const char* font_path, const char* text, float x, float y, float size, float r, float g, float b);
 float get_text_cap_height(const char* font_path, float text_size);
 float get_text_width(const char* font_path, const char* text, float text_size);
+void unload_font(const char* font_path);
+
+// Cached text layout for labels that rarely change (see build_text_mesh).
+// vertex_count is -1 until the mesh is first built.
+struct TextMesh {
+    std::string font_path;
+    std::string text;
+    float size = 0.0f;
+    float width = 0.0f;          // advance width in world units
+    unsigned int tex = 0;        // font atlas
+    unsigned int vbo = 0;        // 0 if the context has no buffer objects
+    int vertex_count = -1;
+    std::vector<float> vertices; // x, y, u, v per vertex, origin at the baseline
+    bool sdf = false;            // built in FontMode::SDF
+    unsigned int sdf_generation = 0;
+    unsigned int font_generation = 0;  // bitmap atlas, see unload_font
+};
+
+bool build_text_mesh(TextMesh& mesh, const char* font_path, const char* text, float size);
+void draw_text_mesh(const TextMesh& mesh, float x, float y, float r, float g, float b);
+void free_text_mesh(TextMesh& mesh);
 
 // Spritesheet slicing
 struct SpriteSheet {
     unsigned int tex;
     int img_w, img_h;
     int cols, rows;
+    float u0 = 0.0f, v0 = 0.0f, u1 = 1.0f, v1 = 1.0f;  // sheet's area of tex
 };
 
 SpriteSheet load_spritesheet(const char* filepath, int cols, int rows);
+SpriteSheet load_spritesheet(const char* filepath, int cols, int rows, const TextureOptions& options);
 void draw_sprite(SpriteSheet sheet, int frame, float x, float y, float w, float h, float* out_corrected_w = nullptr);
 
 #endif
@@ -0,0 +1,56 @@
+// Copyright (c) 2026- b0owl / Brennan Marx-Rennie. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to use,
+// copy, modify, and distribute the Software for NON-COMMERCIAL purposes only,
+// subject to the following conditions:
+//
+// 1. The above copyright notice and this permission notice shall be included
+//    in all copies or substantial portions of the Software.
+// 2. The Software may not be used for commercial purposes without prior
+//    written permission from the copyright holder.
+// 3. Commercial use includes, but is not limited to, selling the Software,
+//    using it in a commercial product, or using it to provide commercial services.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+
+#ifndef RESIDENCY_H
+#define RESIDENCY_H
+
+#include <stddef.h>
+
+// Texture residency
+// Textures loaded by path (load_image, load_spritesheet, draw_image by path)
+// and bitmap font atlases count against a byte budget. When an upload or the
+// end of a frame leaves the total over budget, the least recently drawn ones
+// are evicted: their GPU storage is released but the texture name, the cache
+// entry and any Image / SpriteSheet / TextMesh referring to it stay valid.
+// The next draw that uses an evicted texture reloads it from disk first.
+//
+// Nothing drawn in the current frame is evicted, and pinned paths never are.
+// The budget is 0 (unlimited) by default. Atlas pages and the SDF glyph page
+// manage their own memory and aren't counted.
+
+struct ResidencyStats {
+    size_t budget;          // 0 = unlimited
+    size_t resident_bytes;  // estimated from the upload format
+    size_t evicted_bytes;   // bytes that would come back on reload
+    int    resident;        // textures currently on the GPU
+    int    evicted;         // textures waiting to be reloaded on use
+    int    evictions;       // since startup
+    int    reloads;         // since startup
+};
+
+void residency_set_budget(size_t bytes);
+size_t residency_get_budget();
+size_t residency_resident_bytes();
+ResidencyStats residency_stats();
+
+// Pins are counted; a path stays resident until every pin is released.
+// Pinning a path that isn't loaded yet applies once it is.
+void residency_pin(const char* path);
+void residency_unpin(const char* path);
+
+#endif
@@ -28,6 +28,16 @@ GLFWwindow* create_window(int x_dim, int y_dim, const char* title_bar);
 // Initialization
 void init_bytee();
 
+// Headless mode, for benchmarks and tests on machines without a display.
+// Offscreen renders into an OSMesa context; Null has no context and uses the
+// null renderer (also the fallback when Offscreen can't get a context).
+// Needs GLFW 3.4+. Set it before init_bytee / create_window; the
+// BYTEE_HEADLESS environment variable (offscreen / null) overrides it.
+enum class HeadlessMode { Off, Offscreen, Null };
+
+void set_headless_mode(HeadlessMode mode);
+HeadlessMode get_headless_mode();
+
 // Default configurations
 float setup_2d_orthographic(GLFWwindow *window, std::array<float, 4>);
 
@@ -59,7 +69,10 @@ void update_viewport(GLFWwindow* window, int* fb_w, int* fb_h, float* aspect);
 
 // Computes delta time since the last call. Initialize *last_time = 0 before
 // the loop; returns elapsed seconds and updates *last_time automatically.
+// Prefer the double version: a float timestamp loses precision after a few
+// hours of uptime.
 float compute_delta_time(float* last_time);
+double compute_delta_time(double* last_time);
 
 // Widget areas
 struct WidgetArea {
@@ -80,5 +93,9 @@ WidgetInfoArea optimal_widget_info_area(const char*  texture_id, int fb_w, int f
 // Text widget areas (keyed by a string id)
 WidgetArea define_text_area(const char* ID, const char* font_path, const char* text, float x, float y, float size);
 
+// The ID of the topmost widget or text area under a point, or nullptr
+const char* widget_at(float world_x, float world_y);
+const char* widget_under_mouse(GLFWwindow* window, int fb_w, int fb_h, float cur_aspect);
+
 
 #endif // WINDOW_H
\ No newline at end of file
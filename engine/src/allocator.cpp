@@ -17,7 +17,189 @@
 // FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
 
 #include "../include/allocator.h"
+#include "../include/batch.h"
+#include "../include/gl_state.h"
+#include "../include/profiler.h"
+#include "render_queue_internal.h"
+#include "gl_functions.h"
+#include "core_backend.h"
+#include "instanced_draw.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
 #include <cstdlib>
+#include <cstring>
+
+// --- DrawPool ----------------------------------------------------------------
+
+// Every live pool, so release_draw_data can find the owner of a pointer.
+// Never destroyed: Allocators at namespace scope release their objects
+// during static destruction, in no particular order relative to this file.
+static std::vector<DrawPool*>& draw_pools() {
+    static std::vector<DrawPool*>* pools = new std::vector<DrawPool*>();
+    return *pools;
+}
+
+DrawPool::DrawPool() {
+    m_free = nullptr;
+    m_bump = 0;
+    m_live = 0;
+    draw_pools().push_back(this);
+}
+
+DrawPool::~DrawPool() {
+    for (DrawPoolChunk* chunk : m_chunks) delete chunk;
+    std::vector<DrawPool*>& pools = draw_pools();
+    pools.erase(std::find(pools.begin(), pools.end(), this));
+}
+
+static DrawPoolChunk* chunk_of(const DrawData* data) {
+    return (DrawPoolChunk*)((uintptr_t)data & ~(uintptr_t)(sizeof(DrawPoolChunk) - 1));
+}
+
+/*
+@brief, constructs a copy of data in the pool. Reuses a destroyed slot if
+        there is one, and allocates a new chunk only when every chunk is full.
+
+@returns a pointer that stays valid until destroy, clear or the pool's destruction
+*/
+DrawData* DrawPool::create(const DrawData& data) {
+    DrawData* slot = m_free;
+    if (slot) {
+        memcpy(&m_free, slot, sizeof(DrawData*));
+    } else {
+        if (m_bump < (int)m_chunks.size() && m_chunks[m_bump]->used == DRAW_POOL_CHUNK) m_bump++;
+        if (m_bump == (int)m_chunks.size()) reserve(size() + DRAW_POOL_CHUNK);
+        DrawPoolChunk* chunk = m_chunks[m_bump];
+        slot = &chunk->items[chunk->used++];
+    }
+
+    *slot = data;
+    DrawPoolChunk* chunk = chunk_of(slot);
+    chunk->live[slot - chunk->items] = 1;
+    m_live++;
+    return slot;
+}
+
+/* @brief, same arguments as createobj, constructed in the pool */
+DrawData* DrawPool::create(const float* vertex_c, int vertex_count, float X, float Y,
+                           float R, float G, float B) {
+    DrawData data = {};
+    memcpy(data.vertices, vertex_c, vertex_count * 2 * sizeof(float));
+    data.vertex_count = vertex_count;
+    data.r = R;
+    data.g = G;
+    data.b = B;
+    data.x = X;
+    data.y = Y;
+    return create(data);
+}
+
+/* @brief, returns data's slot to the pool. data must come from this pool. */
+void DrawPool::destroy(DrawData* data) {
+    if (!data) return;
+    DrawPoolChunk* chunk = chunk_of(data);
+    int index = (int)(data - chunk->items);
+    if (index >= chunk->used || !chunk->live[index]) return;  // already destroyed
+    unsigned char& live = chunk->live[index];
+    live = 0;
+    memcpy(data, &m_free, sizeof(DrawData*));
+    m_free = data;
+    m_live--;
+}
+
+/* @brief, destroys every object but keeps the chunks for reuse */
+void DrawPool::clear() {
+    for (DrawPoolChunk* chunk : m_chunks) chunk->used = 0;
+    m_free = nullptr;
+    m_bump = 0;
+    m_live = 0;
+}
+
+/* @brief, allocates chunks up front so the pool holds count objects without touching the heap */
+void DrawPool::reserve(int count) {
+    while (capacity() < count) {
+        DrawPoolChunk* chunk = new DrawPoolChunk;
+        chunk->used = 0;
+        m_chunks.push_back(chunk);
+        m_sorted.insert(std::upper_bound(m_sorted.begin(), m_sorted.end(), chunk), chunk);
+    }
+}
+
+bool DrawPool::owns(const DrawData* data) const {
+    auto it = std::upper_bound(m_sorted.begin(), m_sorted.end(), (const void*)data,
+        [](const void* p, const DrawPoolChunk* chunk) { return p < (const void*)chunk; });
+    if (it == m_sorted.begin()) return false;
+    const DrawPoolChunk* chunk = *(it - 1);
+    if (data >= chunk->items + chunk->used) return false;
+    return chunk->live[data - chunk->items] != 0;
+}
+
+/*
+@brief, rebuilds out with the position, color and size of every live object,
+        in pool order. The vectors keep their capacity between calls, so
+        refreshing every frame doesn't allocate once they're large enough.
+*/
+void DrawPool::soa(DrawSoA& out) const {
+    out.x.resize(m_live);
+    out.y.resize(m_live);
+    out.r.resize(m_live);
+    out.g.resize(m_live);
+    out.b.resize(m_live);
+    out.width.resize(m_live);
+    out.height.resize(m_live);
+    out.objects.resize(m_live);
+
+    int n = 0;
+    for (DrawPoolChunk* chunk : m_chunks) {
+        for (int i = 0; i < chunk->used; i++) {
+            if (!chunk->live[i]) continue;
+            DrawData& data = chunk->items[i];
+            out.x[n] = data.x;
+            out.y[n] = data.y;
+            out.r[n] = data.r;
+            out.g[n] = data.g;
+            out.b[n] = data.b;
+            out.width[n] = data.width;
+            out.height[n] = data.height;
+            out.objects[n] = &data;
+            n++;
+        }
+    }
+    out.count = n;
+}
+
+/* @brief, fills out with a pointer to every live object, in pool order, for draw_struct */
+int DrawPool::collect(std::vector<void*>& out) const {
+    out.clear();
+    for (DrawPoolChunk* chunk : m_chunks) {
+        for (int i = 0; i < chunk->used; i++) {
+            if (chunk->live[i]) out.push_back(&chunk->items[i]);
+        }
+    }
+    return (int)out.size();
+}
+
+/* @brief, the pool createobj allocates from. Lives until exit, for the same reason as draw_pools. */
+DrawPool& draw_pool_default() {
+    static DrawPool* pool = new DrawPool();
+    return *pool;
+}
+
+/*
+@brief, frees a DrawData whatever it came from: createobj or any DrawPool
+        gets its slot back, anything else is deleted. Use this instead of
+        delete on createobj results, which point into a pool chunk.
+*/
+void release_draw_data(DrawData* data) {
+    if (!data) return;
+    for (DrawPool* pool : draw_pools()) {
+        if (pool->owns(data)) { pool->destroy(data); return; }
+    }
+    delete data;
+}
+
+// --- Allocator ---------------------------------------------------------------
 
 /* Manages persistent heap allocations. Stored pointers are NOT automatically
 cleared - they live until the Allocator is destroyed or explicitly freed. */
@@ -25,14 +207,20 @@ Allocator::Allocator() {
     ptr = nullptr;
     m_pointers = 0;
     m_next_index = 0;
+    m_instanced = nullptr;
 }
 
+/* Frees whatever the previous table still held before starting a new one. */
 void Allocator::create_pointers(int size) {
     if (ptr != nullptr) {
+        for (int i = 0; i < m_pointers; i++) {
+            if (ptr[i] != nullptr) release_draw_data(static_cast<DrawData*>(ptr[i]));
+        }
         free(ptr);
     }
 
     m_pointers = size;
+    m_next_index = 0;
     ptr = (void**)malloc(m_pointers * sizeof(void*));
 
     for (int i = 0; i < m_pointers; i++) {
@@ -40,7 +228,38 @@ void Allocator::create_pointers(int size) {
     }
 }
 
+void Allocator::grow_pointers(int size) {
+    void** grown = (void**)realloc(ptr, size * sizeof(void*));
+    if (!grown) { fprintf(stderr, "[bytee] Allocator: out of memory\n"); abort(); }
+    for (int i = m_pointers; i < size; i++) grown[i] = nullptr;
+    ptr = grown;
+    m_pointers = size;
+}
+
+/* Draws every object, one instanced draw call per distinct shape when the
+context supports it. Only objects whose position or color changed since the
+last call are re-uploaded. Falls back to immediate mode otherwise (legacy
+backend only; GL 3.3 always has instancing). */
 void Allocator::draw_struct(void** ptr, int count) {
+    if (render_queue_recording()) { render_queue_push_shapes(this, ptr, count); return; }
+    batch_flush();
+    ProfileScope scope("draw_struct", true);
+    if (null_backend_active()) {
+        for (int i = 0; i < count; i++)
+            if (ptr[i] != nullptr) gls_count_draw(((DrawData*)ptr[i])->vertex_count);
+        return;
+    }
+    if (gl_has_instancing()) {
+        if (!m_instanced) m_instanced = instanced_create();
+        if (instanced_draw(m_instanced, ptr, count)) return;
+    }
+    if (core_backend_active()) return;  // no immediate mode to fall back to
+
+    // Untextured fixed-function shapes; earlier draws may have left a texture
+    // or program on.
+    gls_use_program(0);
+    gls_disable(GL_TEXTURE_2D);
+
     for (int i = 0; i < count; i++) {
         if (ptr[i] != nullptr) {
             DrawData* data = (DrawData*)ptr[i];
@@ -51,17 +270,258 @@ void Allocator::draw_struct(void** ptr, int count) {
                                data->vertices[j * 2 + 1] + data->y);
                 }
             glEnd();
+            gls_count_draw(data->vertex_count);
         }
     }
 }
 
 Allocator::~Allocator() {
+    instanced_destroy(m_instanced);
     if (ptr != nullptr) {
         for (int i = 0; i < m_pointers; i++) {
             if (ptr[i] != nullptr) {
-                delete static_cast<DrawData*>(ptr[i]);
+                release_draw_data(static_cast<DrawData*>(ptr[i]));
             }
         }
         free(ptr);
     }
 }
+
+// --- FrameAllocator ----------------------------------------------------------
+
+/* Arenas are allocated on first use, so an unused FrameAllocator costs
+nothing but the object itself. */
+FrameAllocator::FrameAllocator(size_t arena_bytes) {
+    ptr = nullptr;
+    prev = nullptr;
+    m_pointers = 0;
+    m_prev_count = 0;
+    m_next_index = 0;
+    m_current = 0;
+    m_arenas[0].size = arena_bytes;
+    m_arenas[1].size = arena_bytes;
+}
+
+static void arena_release(FrameArena& arena) {
+    for (void* block : arena.overflow) free(block);
+    arena.overflow.clear();
+}
+
+FrameAllocator::~FrameAllocator() {
+    for (FrameArena& arena : m_arenas) {
+        arena_release(arena);
+        free(arena.base);
+    }
+    free(ptr);
+    free(prev);
+}
+
+void FrameAllocator::create_pointers(int size) {
+    free(ptr);
+    free(prev);
+    m_pointers = size;
+    ptr = (void**)calloc(size > 0 ? size : 1, sizeof(void*));
+    prev = (void**)calloc(size > 0 ? size : 1, sizeof(void*));
+    m_next_index = 0;
+    m_prev_count = 0;
+}
+
+void FrameAllocator::grow_pointers(int size) {
+    void** grown = (void**)realloc(ptr, size * sizeof(void*));
+    void** grown_prev = (void**)realloc(prev, size * sizeof(void*));
+    if (!grown || !grown_prev) { fprintf(stderr, "[bytee] FrameAllocator: out of memory\n"); abort(); }
+    for (int i = m_pointers; i < size; i++) grown[i] = grown_prev[i] = nullptr;
+    ptr = grown;
+    prev = grown_prev;
+    m_pointers = size;
+}
+
+static void* align_up(void* p, size_t align) {
+    return (void*)(((uintptr_t)p + (align - 1)) & ~(uintptr_t)(align - 1));
+}
+
+/*
+@brief, returns bytes of memory aligned to align (a power of two) that stays
+        valid until the end_frame after next. Past the arena's size the
+        memory comes from the heap for the rest of the frame.
+*/
+void* FrameAllocator::alloc(size_t bytes, size_t align) {
+    FrameArena& arena = m_arenas[m_current];
+    if (!arena.base && arena.size > 0) arena.base = (unsigned char*)malloc(arena.size);
+
+    if (arena.base) {
+        unsigned char* p = (unsigned char*)align_up(arena.base + arena.used, align);
+        if (p + bytes <= arena.base + arena.size) {
+            arena.used = (size_t)(p - arena.base) + bytes;
+            return p;
+        }
+    }
+
+    void* block = malloc(bytes + align);
+    if (!block) { fprintf(stderr, "[bytee] FrameAllocator: out of memory\n"); abort(); }
+    arena.overflow.push_back(block);
+    arena.overflow_bytes += bytes + align;
+    return align_up(block, align);
+}
+
+/* @brief, same arguments as createobj, allocated in this frame's arena */
+DrawData* FrameAllocator::createobj(const float* vertex_c, int vertex_count, float X, float Y,
+                                    float R, float G, float B) {
+    DrawData* data = create<DrawData>();
+    memcpy(data->vertices, vertex_c, vertex_count * 2 * sizeof(float));
+    data->vertex_count = vertex_count;
+    data->r = R;
+    data->g = G;
+    data->b = B;
+    data->x = X;
+    data->y = Y;
+    return data;
+}
+
+/* @brief, copies length chars of text plus a terminator into the arena */
+const char* FrameAllocator::copy_string(const char* text, size_t length) {
+    char* copy = (char*)alloc(length + 1, 1);
+    memcpy(copy, text, length);
+    copy[length] = '\0';
+    return copy;
+}
+
+/*
+@brief, finishes the frame: this frame's pointers move to prev, ptr is
+        cleared, and the arena from two frames ago is reset for reuse. An
+        arena that overflowed is reallocated once here with room for
+        everything it held.
+*/
+void FrameAllocator::end_frame() {
+    void** done = ptr;
+    ptr = prev;
+    prev = done;
+    for (int i = 0; i < m_prev_count; i++) ptr[i] = nullptr;
+    m_prev_count = m_next_index;
+    m_next_index = 0;
+
+    m_current ^= 1;
+    FrameArena& arena = m_arenas[m_current];
+    if (arena.overflow_bytes > 0) {
+        arena_release(arena);
+        free(arena.base);
+        arena.base = nullptr;  // reallocated on the next alloc
+        arena.size += arena.overflow_bytes;
+        arena.overflow_bytes = 0;
+    }
+    arena.used = 0;
+}
+
+FrameAllocator& frame_allocator_default() {
+    static FrameAllocator* allocator = new FrameAllocator();
+    return *allocator;
+}
+
+// --- StaticAllocator ---------------------------------------------------------
+
+StaticAllocator::StaticAllocator() {
+    ptr = nullptr;
+    m_pointers = 0;
+    m_capacity = 0;
+    m_free_slot = -1;
+}
+
+StaticAllocator::~StaticAllocator() {
+    drop_all(true);
+    free(ptr);
+}
+
+void StaticAllocator::create_pointers(int size) {
+    clear();
+    reserve(size);
+}
+
+void StaticAllocator::reserve(int size) {
+    if (size <= m_capacity) return;
+    void** grown = (void**)realloc(ptr, size * sizeof(void*));
+    if (!grown) { fprintf(stderr, "[bytee] StaticAllocator: out of memory\n"); abort(); }
+    ptr = grown;
+    m_capacity = size;
+    m_slots.reserve(size);
+    m_dense_slots.reserve(size);
+}
+
+/*
+@brief, stores value and returns its handle. A freed slot is reused if there
+        is one; its generation was bumped on erase, so old handles to it stay
+        invalid.
+*/
+StaticHandle StaticAllocator::insert(void* value) {
+    if (m_pointers == m_capacity) reserve(m_capacity > 0 ? m_capacity * 2 : 16);
+
+    unsigned int index;
+    if (m_free_slot >= 0) {
+        index = (unsigned int)m_free_slot;
+        m_free_slot = m_slots[index].dense;
+    } else {
+        index = (unsigned int)m_slots.size();
+        m_slots.push_back({ 1, 0 });
+    }
+
+    Slot& slot = m_slots[index];
+    slot.dense = m_pointers;
+    ptr[m_pointers] = value;
+    m_dense_slots.push_back(index);
+    m_pointers++;
+    return { index, slot.generation };
+}
+
+bool StaticAllocator::valid(StaticHandle handle) const {
+    return handle.index < m_slots.size() && handle.generation != 0 &&
+           m_slots[handle.index].generation == handle.generation;
+}
+
+/* @brief, the object behind handle, or nullptr if it was erased */
+DrawData* StaticAllocator::get(StaticHandle handle) const {
+    if (!valid(handle)) return nullptr;
+    return static_cast<DrawData*>(ptr[m_slots[handle.index].dense]);
+}
+
+StaticHandle StaticAllocator::handle_at(int index) const {
+    unsigned int slot = m_dense_slots[index];
+    return { slot, m_slots[slot].generation };
+}
+
+/*
+@brief, frees the object behind handle and invalidates the handle. The last
+        object in ptr moves into the hole. Returns false for stale handles.
+*/
+bool StaticAllocator::erase(StaticHandle handle) {
+    if (!valid(handle)) return false;
+    Slot& slot = m_slots[handle.index];
+    int hole = slot.dense;
+    if (ptr[hole] != nullptr) release_draw_data(static_cast<DrawData*>(ptr[hole]));
+
+    int last = m_pointers - 1;
+    ptr[hole] = ptr[last];
+    m_dense_slots[hole] = m_dense_slots[last];
+    m_slots[m_dense_slots[hole]].dense = hole;
+    m_dense_slots.pop_back();
+    m_pointers--;
+
+    if (++slot.generation == 0) slot.generation = 1;
+    slot.dense = m_free_slot;
+    m_free_slot = (int)handle.index;
+    return true;
+}
+
+/* @brief, erases everything, optionally without freeing the objects */
+void StaticAllocator::drop_all(bool release) {
+    for (int i = 0; i < m_pointers; i++) {
+        if (release && ptr[i] != nullptr) release_draw_data(static_cast<DrawData*>(ptr[i]));
+        Slot& slot = m_slots[m_dense_slots[i]];
+        if (++slot.generation == 0) slot.generation = 1;
+        slot.dense = m_free_slot;
+        m_free_slot = (int)m_dense_slots[i];
+    }
+    m_dense_slots.clear();
+    m_pointers = 0;
+}
+
+void StaticAllocator::clear() { drop_all(true); }
+void StaticAllocator::reset_index() { drop_all(false); }
@@ -0,0 +1,238 @@
+// Copyright (c) 2026- b0owl / Brennan Marx-Rennie. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to use,
+// copy, modify, and distribute the Software for NON-COMMERCIAL purposes only,
+// subject to the following conditions:
+//
+// 1. The above copyright notice and this permission notice shall be included
+//    in all copies or substantial portions of the Software.
+// 2. The Software may not be used for commercial purposes without prior
+//    written permission from the copyright holder.
+// 3. Commercial use includes, but is not limited to, selling the Software,
+//    using it in a commercial product, or using it to provide commercial services.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "../include/assets.h"
+#include "rendering_internal.h"
+
+struct AssetJob {
+    int id;
+    bool is_font;
+    std::string path;
+};
+
+struct AssetResult {
+    int id;
+    bool is_font;
+    bool ok;
+    std::string path;
+    DecodedImage image;
+    DecodedFont font;
+};
+
+// Everything below is guarded by asset_mutex.
+static std::mutex                           asset_mutex;
+static std::condition_variable              asset_cv;
+static std::deque<AssetJob>                 asset_jobs;
+static std::deque<AssetResult>              asset_done;
+static std::vector<AssetState>              asset_states;
+static std::unordered_map<std::string, int> asset_inflight;  // key -> handle id
+static std::unordered_map<std::string, int> asset_ids;       // key -> latest handle id
+static std::vector<std::thread>             asset_workers;
+static bool                                 asset_stop = false;
+
+static int    asset_worker_count     = 0;    // 0 = hardware_concurrency - 1
+static double asset_upload_budget_ms = 2.0;
+
+// Joins the workers at exit. Declared after the state above so it is
+// destroyed first, while the queues still exist.
+static struct AssetShutdown {
+    ~AssetShutdown() {
+        {
+            std::lock_guard<std::mutex> lock(asset_mutex);
+            asset_stop = true;
+        }
+        asset_cv.notify_all();
+        for (std::thread& t : asset_workers) t.join();
+        for (AssetResult& r : asset_done) {
+            if (!r.is_font && r.ok) free_decoded_image(r.image);
+        }
+    }
+} asset_shutdown;
+
+static std::string inflight_key(bool is_font, const std::string& path) {
+    return (is_font ? "f:" : "i:") + path;
+}
+
+static void asset_worker() {
+    for (;;) {
+        AssetJob job;
+        {
+            std::unique_lock<std::mutex> lock(asset_mutex);
+            asset_cv.wait(lock, [] { return asset_stop || !asset_jobs.empty(); });
+            if (asset_stop) return;
+            job = std::move(asset_jobs.front());
+            asset_jobs.pop_front();
+        }
+
+        AssetResult result;
+        result.id = job.id;
+        result.is_font = job.is_font;
+        result.path = std::move(job.path);
+        result.image.pixels = nullptr;
+        if (result.is_font) result.ok = bake_font(result.path.c_str(), result.font);
+        else                result.ok = decode_image(result.path.c_str(), result.image);
+
+        std::lock_guard<std::mutex> lock(asset_mutex);
+        asset_done.push_back(std::move(result));
+    }
+}
+
+// Caller holds asset_mutex.
+static void start_workers() {
+    if (!asset_workers.empty()) return;
+    int count = asset_worker_count;
+    if (count <= 0) count = (int)std::thread::hardware_concurrency() - 1;
+    if (count < 1) count = 1;
+    for (int i = 0; i < count; i++) asset_workers.emplace_back(asset_worker);
+}
+
+static AssetHandle request_asset(const char* path, bool is_font) {
+    bool cached = is_font ? find_cached_font(path) != nullptr
+                          : find_cached_texture(path) != nullptr;
+
+    std::string key = inflight_key(is_font, path);
+    std::lock_guard<std::mutex> lock(asset_mutex);
+    int id = (int)asset_states.size();
+    if (cached) {
+        // Polling a cached path every frame must not grow asset_states, so
+        // the path keeps its handle while that handle is ready.
+        auto known = asset_ids.find(key);
+        if (known != asset_ids.end() && asset_states[known->second] == AssetState::Ready) return { known->second };
+        asset_states.push_back(AssetState::Ready);
+        asset_ids[key] = id;
+        return { id };
+    }
+
+    auto it = asset_inflight.find(key);
+    if (it != asset_inflight.end()) return { it->second };
+
+    asset_states.push_back(AssetState::Pending);
+    asset_inflight[key] = id;
+    asset_ids[key] = id;
+    asset_jobs.push_back({ id, is_font, path });
+    start_workers();
+    asset_cv.notify_one();
+    return { id };
+}
+
+/*
+@brief, queues an image for background decoding. Use it with load_image or
+        load_spritesheet once asset_ready reports true. Requesting a file that
+        is already loading returns the same handle.
+
+@param filepath, path to the image file
+@returns a handle to poll with asset_state / asset_ready
+*/
+AssetHandle load_texture_async(const char* filepath) {
+    return request_asset(filepath, false);
+}
+
+/*
+@brief, queues a TTF for background baking. Once ready, draw_text and the
+        text measuring functions use it without stalling.
+
+@param font_path, path to a .ttf file
+@returns a handle to poll with asset_state / asset_ready
+*/
+AssetHandle load_font_async(const char* font_path) {
+    return request_asset(font_path, true);
+}
+
+AssetState asset_state(AssetHandle handle) {
+    std::lock_guard<std::mutex> lock(asset_mutex);
+    if (handle.id < 0 || handle.id >= (int)asset_states.size()) return AssetState::Failed;
+    return asset_states[handle.id];
+}
+
+bool asset_ready(AssetHandle handle) {
+    return asset_state(handle) == AssetState::Ready;
+}
+
+/* @brief, number of requested assets that are not uploaded yet */
+int assets_pending() {
+    std::lock_guard<std::mutex> lock(asset_mutex);
+    return (int)asset_inflight.size();
+}
+
+/* @brief, number of decode threads. Only takes effect before the first async load. */
+void set_asset_workers(int count) { asset_worker_count = count; }
+
+/* @brief, time glCleanup may spend uploading finished assets each frame */
+void set_asset_upload_budget(double ms) { asset_upload_budget_ms = ms; }
+
+/*
+@brief, uploads decoded assets to the GPU until budget_ms is used up. At least
+        one asset is uploaded per call if any is waiting, so progress is made
+        even with a tiny budget. Must be called on the GL thread; glCleanup
+        already does this every frame.
+
+@param budget_ms, time budget in milliseconds; negative uses the value from
+                  set_asset_upload_budget
+@returns the number of assets uploaded
+*/
+int process_asset_uploads(double budget_ms) {
+    if (budget_ms < 0.0) budget_ms = asset_upload_budget_ms;
+    auto start = std::chrono::steady_clock::now();
+    int uploaded = 0;
+
+    for (;;) {
+        AssetResult result;
+        {
+            std::lock_guard<std::mutex> lock(asset_mutex);
+            if (asset_done.empty()) break;
+            result = std::move(asset_done.front());
+            asset_done.pop_front();
+        }
+
+        bool ok = result.ok;
+        if (ok && result.is_font) {
+            ok = cache_font(result.path, result.font) != nullptr;
+        } else if (ok) {
+            ok = cache_texture(result.path, result.image, get_texture_options()) != nullptr;
+            free_decoded_image(result.image);
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(asset_mutex);
+            asset_states[result.id] = ok ? AssetState::Ready : AssetState::Failed;
+            asset_inflight.erase(inflight_key(result.is_font, result.path));
+        }
+        uploaded++;
+
+        std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+        if (elapsed.count() >= budget_ms) break;
+    }
+    return uploaded;
+}
+
+/* @brief, blocks until every requested asset is uploaded. Must be called on the GL thread. */
+void wait_for_assets() {
+    while (assets_pending() > 0) {
+        if (process_asset_uploads(1000.0) == 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+}
@@ -0,0 +1,283 @@
+// Copyright (c) 2026- b0owl / Brennan Marx-Rennie. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to use,
+// copy, modify, and distribute the Software for NON-COMMERCIAL purposes only,
+// subject to the following conditions:
+//
+// 1. The above copyright notice and this permission notice shall be included
+//    in all copies or substantial portions of the Software.
+// 2. The Software may not be used for commercial purposes without prior
+//    written permission from the copyright holder.
+// 3. Commercial use includes, but is not limited to, selling the Software,
+//    using it in a commercial product, or using it to provide commercial services.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+
+#ifdef __APPLE__
+  #include <OpenGL/gl.h>
+#else
+  #include <GL/gl.h>
+#endif
+
+#include "../vendor/stb_image.h"
+
+#include <climits>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include "../include/atlas.h"
+#include "../include/batch.h"
+#include "../include/gl_state.h"
+#include "../include/render_queue.h"
+#include "../include/profiler.h"
+#include "core_backend.h"
+#include "profiler_internal.h"
+
+// --- Skyline packer ----------------------------------------------------------
+
+SkylinePacker::SkylinePacker() {
+    m_width = 0;
+    m_height = 0;
+    m_used_area = 0;
+}
+
+void SkylinePacker::reset(int width, int height) {
+    m_width = width;
+    m_height = height;
+    m_used_area = 0;
+    m_skyline.clear();
+    m_skyline.push_back({ 0, 0, width });
+}
+
+// Checks whether a w*h rect fits with its left edge on skyline node `index`.
+// out_y is the lowest y it can rest at without intersecting the skyline.
+bool SkylinePacker::fits(int index, int w, int h, int& out_y) const {
+    int x = m_skyline[index].x;
+    if (x + w > m_width) return false;
+
+    int y = 0;
+    int width_left = w;
+    for (int i = index; width_left > 0; i++) {
+        if (m_skyline[i].y > y) y = m_skyline[i].y;
+        if (y + h > m_height) return false;
+        width_left -= m_skyline[i].w;
+    }
+    out_y = y;
+    return true;
+}
+
+/*
+@brief, finds a spot for a w*h rect using the bottom-left heuristic: lowest
+        resulting top edge wins, ties go to the narrowest skyline segment.
+
+@param w/h,     rect size in pixels
+@param out_x/y, written with the rect's top-left position on success
+@returns false if the page has no room left for the rect
+*/
+bool SkylinePacker::pack(int w, int h, int& out_x, int& out_y) {
+    int best_index = -1;
+    int best_top = INT_MAX;
+    int best_width = INT_MAX;
+    int best_y = 0;
+
+    for (int i = 0; i < (int)m_skyline.size(); i++) {
+        int y;
+        if (!fits(i, w, h, y)) continue;
+        if (y + h < best_top || (y + h == best_top && m_skyline[i].w < best_width)) {
+            best_index = i;
+            best_top = y + h;
+            best_width = m_skyline[i].w;
+            best_y = y;
+        }
+    }
+    if (best_index < 0) return false;
+
+    int x = m_skyline[best_index].x;
+    m_skyline.insert(m_skyline.begin() + best_index, { x, best_y + h, w });
+
+    // Trim the segments now hidden underneath the new one.
+    for (int i = best_index + 1; i < (int)m_skyline.size(); i++) {
+        Node& prev = m_skyline[i - 1];
+        Node& node = m_skyline[i];
+        int prev_end = prev.x + prev.w;
+        if (node.x >= prev_end) break;
+
+        int shrink = prev_end - node.x;
+        node.x += shrink;
+        node.w -= shrink;
+        if (node.w > 0) break;
+        m_skyline.erase(m_skyline.begin() + i);
+        i--;
+    }
+
+    // Merge neighbours at the same height.
+    for (int i = 0; i + 1 < (int)m_skyline.size(); i++) {
+        if (m_skyline[i].y == m_skyline[i + 1].y) {
+            m_skyline[i].w += m_skyline[i + 1].w;
+            m_skyline.erase(m_skyline.begin() + i + 1);
+            i--;
+        }
+    }
+
+    m_used_area += (long long)w * h;
+    out_x = x;
+    out_y = best_y;
+    return true;
+}
+
+/* @brief, fraction of the page area covered by packed rects, 0..1 */
+float SkylinePacker::occupancy() const {
+    if (m_width == 0 || m_height == 0) return 0.0f;
+    return (float)m_used_area / ((float)m_width * (float)m_height);
+}
+
+// --- Atlas pages -------------------------------------------------------------
+
+// Every packed image gets a 1px border copied from its own edge pixels, so
+// linear filtering at the region edge never samples a neighbouring image.
+static const int ATLAS_PADDING = 1;
+
+struct AtlasPage {
+    unsigned int tex;
+    SkylinePacker packer;
+};
+
+static int atlas_page_size = 2048;
+static std::vector<AtlasPage> atlas_pages;
+static std::unordered_map<std::string, AtlasRegion> atlas_cache;
+
+/* @brief, sets the width/height of new atlas pages. Only affects pages created afterwards. */
+void atlas_set_page_size(int size) { atlas_page_size = size; }
+
+int atlas_page_count() { return (int)atlas_pages.size(); }
+
+/* @brief, deletes every atlas page. Regions handed out before are invalid afterwards. */
+void atlas_clear() {
+    render_queue_flush();  // pending quads may still sample a page
+    for (AtlasPage& page : atlas_pages) gls_delete_texture(page.tex);
+    atlas_pages.clear();
+    atlas_cache.clear();
+}
+
+static AtlasPage& new_atlas_page() {
+    AtlasPage page;
+    page.tex = gls_gen_texture();
+    if (!null_backend_active()) {
+        gls_bind_texture(page.tex);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, atlas_page_size, atlas_page_size,
+                     0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    }
+    page.packer.reset(atlas_page_size, atlas_page_size);
+    atlas_pages.push_back(page);
+    return atlas_pages.back();
+}
+
+// Copies an RGBA image into a buffer with its edge pixels extruded by `pad`.
+static void extrude_rgba(const unsigned char* src, int w, int h, int pad, std::vector<unsigned char>& out) {
+    int pw = w + pad * 2;
+    int ph = h + pad * 2;
+    out.resize((size_t)pw * ph * 4);
+    for (int y = 0; y < ph; y++) {
+        int sy = y - pad;
+        if (sy < 0) sy = 0;
+        if (sy >= h) sy = h - 1;
+        for (int x = 0; x < pw; x++) {
+            int sx = x - pad;
+            if (sx < 0) sx = 0;
+            if (sx >= w) sx = w - 1;
+            memcpy(&out[((size_t)y * pw + x) * 4], &src[((size_t)sy * w + sx) * 4], 4);
+        }
+    }
+}
+
+/*
+@brief, packs an image into an atlas page and returns where it ended up.
+        Cached by path. Images too large for a page get their own texture
+        (through load_image) with full-texture UVs.
+
+@param filepath, path to the image file
+@returns the packed region, or a zeroed region if the file can't be loaded
+*/
+AtlasRegion atlas_add_image(const char* filepath) {
+    auto it = atlas_cache.find(filepath);
+    if (it != atlas_cache.end()) { prof_cache_hit(); return it->second; }
+    prof_cache_miss();
+    PROFILE_SCOPE("atlas_add_image");
+
+    AtlasRegion region = { 0, 0, 0, 0.0f, 0.0f, 1.0f, 1.0f };
+
+    int img_w, img_h, channels;
+    unsigned char* data = stbi_load(filepath, &img_w, &img_h, &channels, 4);
+    if (!data) return region;
+
+    int pw = img_w + ATLAS_PADDING * 2;
+    int ph = img_h + ATLAS_PADDING * 2;
+    if (pw > atlas_page_size || ph > atlas_page_size) {
+        stbi_image_free(data);
+        Image image = load_image(filepath);
+        region.tex = image.tex;
+        region.w = image.img_w;
+        region.h = image.img_h;
+        atlas_cache[filepath] = region;
+        return region;
+    }
+
+    AtlasPage* page = nullptr;
+    int px = 0, py = 0;
+    for (AtlasPage& candidate : atlas_pages) {
+        if (candidate.packer.pack(pw, ph, px, py)) { page = &candidate; break; }
+    }
+    if (!page) {
+        page = &new_atlas_page();
+        page->packer.pack(pw, ph, px, py);
+    }
+
+    std::vector<unsigned char> padded;
+    extrude_rgba(data, img_w, img_h, ATLAS_PADDING, padded);
+    stbi_image_free(data);
+
+    // under the null renderer the region is still packed so layout matches a real atlas
+    if (!null_backend_active()) {
+        gls_bind_texture(page->tex);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        glTexSubImage2D(GL_TEXTURE_2D, 0, px, py, pw, ph, GL_RGBA, GL_UNSIGNED_BYTE, padded.data());
+    }
+
+    float inv = 1.0f / (float)atlas_page_size;
+    region.tex = page->tex;
+    region.w = img_w;
+    region.h = img_h;
+    region.u0 = (px + ATLAS_PADDING) * inv;
+    region.v0 = (py + ATLAS_PADDING) * inv;
+    region.u1 = (px + ATLAS_PADDING + img_w) * inv;
+    region.v1 = (py + ATLAS_PADDING + img_h) * inv;
+
+    atlas_cache[filepath] = region;
+    return region;
+}
+
+/* @brief, like load_image, but the image is packed into a shared atlas page */
+Image load_image_atlas(const char* filepath) {
+    AtlasRegion r = atlas_add_image(filepath);
+    Image image = { r.tex, r.w, r.h };
+    image.u0 = r.u0; image.v0 = r.v0;
+    image.u1 = r.u1; image.v1 = r.v1;
+    return image;
+}
+
+/* @brief, like load_spritesheet, but the sheet is packed into a shared atlas page */
+SpriteSheet load_spritesheet_atlas(const char* filepath, int cols, int rows) {
+    AtlasRegion r = atlas_add_image(filepath);
+    SpriteSheet ss = { r.tex, r.w, r.h, cols, rows };
+    ss.u0 = r.u0; ss.v0 = r.v0;
+    ss.u1 = r.u1; ss.v1 = r.v1;
+    return ss;
+}
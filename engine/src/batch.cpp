@@ -0,0 +1,151 @@
+// Copyright (c) 2026- b0owl / Brennan Marx-Rennie. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to use,
+// copy, modify, and distribute the Software for NON-COMMERCIAL purposes only,
+// subject to the following conditions:
+//
+// 1. The above copyright notice and this permission notice shall be included
+//    in all copies or substantial portions of the Software.
+// 2. The Software may not be used for commercial purposes without prior
+//    written permission from the copyright holder.
+// 3. Commercial use includes, but is not limited to, selling the Software,
+//    using it in a commercial product, or using it to provide commercial services.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+
+#ifdef __APPLE__
+  #include <OpenGL/gl.h>
+#else
+  #include <GL/gl.h>
+#endif
+
+#include <vector>
+#include "../include/batch.h"
+#include "../include/gl_state.h"
+#include "../include/render_queue.h"
+#include "../include/profiler.h"
+#include "rendering_internal.h"
+#include "render_queue_internal.h"
+#include "core_backend.h"
+
+// Quads are stored as two triangles so the same buffer layout works for any
+// backend that lacks GL_QUADS.
+static const int BATCH_MAX_QUADS = 4096;
+static const int VERTS_PER_QUAD  = 6;
+
+struct BatchRun {
+    unsigned int tex;
+    int shader;  // BatchShader
+    int blend;   // BlendMode
+    int first;   // first vertex of the run
+    int count;   // vertex count of the run
+};
+
+static std::vector<BatchVertex> batch_verts;
+static std::vector<BatchRun>    batch_runs;
+
+/*
+@brief, starts a fresh batch. Anything still pending is flushed first,
+        so it is always safe to call.
+*/
+void batch_begin() {
+    if (batch_verts.capacity() == 0) {
+        batch_verts.reserve(BATCH_MAX_QUADS * VERTS_PER_QUAD);
+        batch_runs.reserve(64);
+    }
+    batch_flush();
+}
+
+/*
+@brief, appends a textured quad to the batch. Consecutive quads with the same
+        texture, shader and blend mode are merged into a single run. Flushes
+        automatically when full. With the render queue on, the quad is
+        recorded there instead.
+
+@param tex,       GL texture to sample
+@param x0/y0,     bottom-left corner in world coordinates
+@param x1/y1,     top-right corner in world coordinates
+@param u0/v0,     texture coordinate at (x0, y0)
+@param u1/v1,     texture coordinate at (x1, y1)
+@param r/g/b/a,   vertex color, multiplied with the texture
+@param shader,    BatchShader to draw the quad with
+*/
+void batch_submit(unsigned int tex, float x0, float y0, float x1, float y1,
+                  float u0, float v0, float u1, float v1,
+                  float r, float g, float b, float a, int shader) {
+    if (render_queue_recording()) {
+        render_queue_push_quad(tex, shader, x0, y0, x1, y1, u0, v0, u1, v1, r, g, b, a);
+        return;
+    }
+
+    if (batch_verts.capacity() == 0) batch_begin();
+    if ((int)batch_verts.size() >= BATCH_MAX_QUADS * VERTS_PER_QUAD) batch_flush();
+
+    int blend = render_state_blend();
+    if (batch_runs.empty() || batch_runs.back().tex != tex ||
+        batch_runs.back().shader != shader || batch_runs.back().blend != blend) {
+        batch_runs.push_back({ tex, shader, blend, (int)batch_verts.size(), 0 });
+    }
+    if (blend == (int)BlendMode::Premultiplied) { r *= a; g *= a; b *= a; }
+
+    BatchVertex bl = { x0, y0, u0, v0, r, g, b, a };
+    BatchVertex br = { x1, y0, u1, v0, r, g, b, a };
+    BatchVertex tr = { x1, y1, u1, v1, r, g, b, a };
+    BatchVertex tl = { x0, y1, u0, v1, r, g, b, a };
+
+    batch_verts.push_back(bl); batch_verts.push_back(br); batch_verts.push_back(tr);
+    batch_verts.push_back(bl); batch_verts.push_back(tr); batch_verts.push_back(tl);
+    batch_runs.back().count += VERTS_PER_QUAD;
+}
+
+/* @brief, draws every pending quad, one glDrawArrays per texture/shader run */
+void batch_flush() {
+    if (batch_runs.empty()) return;
+    ProfileScope scope("batch_flush", true);
+
+    if (null_backend_active()) {
+        for (const BatchRun& run : batch_runs) gls_count_draw(run.count);
+        batch_verts.clear();
+        batch_runs.clear();
+        return;
+    }
+
+    const BatchVertex* base = batch_verts.data();
+    bool core = core_backend_active();
+
+    gls_enable(GL_BLEND);
+    if (core) {
+        core_begin_sprites(base, (int)batch_verts.size());
+    } else {
+        gls_enable(GL_TEXTURE_2D);
+        gls_enable_client(GL_VERTEX_ARRAY);
+        gls_enable_client(GL_TEXTURE_COORD_ARRAY);
+        gls_enable_client(GL_COLOR_ARRAY);
+        glVertexPointer(2,   GL_FLOAT, sizeof(BatchVertex), &base->x);
+        glTexCoordPointer(2, GL_FLOAT, sizeof(BatchVertex), &base->u);
+        glColorPointer(4,    GL_FLOAT, sizeof(BatchVertex), &base->r);
+    }
+
+    // State is set per run and left as is afterwards; gl_state skips
+    // whatever is already current.
+    for (const BatchRun& run : batch_runs) {
+        if (core) core_use_sprite_shader(run.shader);
+        else if (run.shader == BATCH_SHADER_SDF) sdf_shader_begin();
+        else sdf_shader_none();
+        render_apply_blend(run.blend);
+        gls_bind_texture(run.tex);
+        glDrawArrays(GL_TRIANGLES, run.first, run.count);
+        gls_count_draw(run.count);
+    }
+
+    batch_verts.clear();
+    batch_runs.clear();
+}
+
+/* @brief, number of quads waiting for the next flush */
+int batch_pending_quads() {
+    return (int)batch_verts.size() / VERTS_PER_QUAD;
+}
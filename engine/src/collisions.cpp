@@ -0,0 +1,954 @@
+// Copyright (c) 2026- b0owl / Brennan Marx-Rennie. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to use,
+// copy, modify, and distribute the Software for NON-COMMERCIAL purposes only,
+// subject to the following conditions:
+//
+// 1. The above copyright notice and this permission notice shall be included
+//    in all copies or substantial portions of the Software.
+// 2. The Software may not be used for commercial purposes without prior
+//    written permission from the copyright holder.
+// 3. Commercial use includes, but is not limited to, selling the Software,
+//    using it in a commercial product, or using it to provide commercial services.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+
+#include "../include/collisions.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+  #define AABB_X86 1
+  #include <immintrin.h>
+  #ifdef _MSC_VER
+    #include <intrin.h>
+  #endif
+#endif
+
+// An object spanning more cells than this is kept out of the grid and tested
+// against everything instead, so one huge box can't flood the table.
+static const int MAX_CELLS_PER_OBJECT = 64;
+static const float MAX_CELL_COORD = 1073741824.0f;  // 2^30, keeps cell math in int range
+
+SpatialHash::SpatialHash(float cell_size) {
+    m_cell_size = cell_size;
+    m_cell = cell_size > 0.0f ? cell_size : 64.0f;
+    m_inv_cell = 1.0f / m_cell;
+    m_bucket_mask = 0;
+}
+
+static int to_cell(float v, float inv_cell) {
+    float c = std::floor(v * inv_cell);
+    if (!(c > -MAX_CELL_COORD)) return -(int)MAX_CELL_COORD;  // also catches NaN
+    if (c > MAX_CELL_COORD) return (int)MAX_CELL_COORD;
+    return (int)c;
+}
+
+void SpatialHash::cell_range(float x0, float y0, float x1, float y1,
+                             int& cx0, int& cy0, int& cx1, int& cy1) const {
+    cx0 = to_cell(x0, m_inv_cell);
+    cy0 = to_cell(y0, m_inv_cell);
+    cx1 = to_cell(x1, m_inv_cell);
+    cy1 = to_cell(y1, m_inv_cell);
+}
+
+unsigned int SpatialHash::bucket(int cx, int cy) const {
+    return (((unsigned int)cx * 0x8da6b343u) ^ ((unsigned int)cy * 0xd8163841u)) & m_bucket_mask;
+}
+
+static long long cell_count(int cx0, int cy0, int cx1, int cy1) {
+    return ((long long)cx1 - cx0 + 1) * ((long long)cy1 - cy0 + 1);
+}
+
+/*
+@brief, snapshots the bounds of every non-null object in ptr and bins them
+        into the grid. Call again after objects move; the previous contents
+        are discarded.
+
+@param ptr, array of DrawData pointers, as stored in an Allocator
+@param count, length of ptr
+*/
+void SpatialHash::build(void** ptr, int count) {
+    m_index.clear();
+    m_x0.clear(); m_y0.clear(); m_x1.clear(); m_y1.clear();
+    double size_sum = 0.0;
+    for (int i = 0; i < count; i++) {
+        if (ptr[i] == nullptr) continue;
+        const DrawData* d = (const DrawData*)ptr[i];
+        float xa = d->x, xb = d->x + d->width;
+        float ya = d->y, yb = d->y + d->height;
+        m_index.push_back(i);
+        m_x0.push_back(std::min(xa, xb));
+        m_x1.push_back(std::max(xa, xb));
+        m_y0.push_back(std::min(ya, yb));
+        m_y1.push_back(std::max(ya, yb));
+        size_sum += std::max(std::fabs(d->width), std::fabs(d->height));
+    }
+    int n = (int)m_index.size();
+
+    if (m_cell_size > 0.0f) m_cell = m_cell_size;
+    else m_cell = n > 0 ? std::max(1.0f, (float)(2.0 * size_sum / n)) : 64.0f;
+    m_inv_cell = 1.0f / m_cell;
+
+    m_cx0.resize(n); m_cy0.resize(n); m_cx1.resize(n); m_cy1.resize(n);
+    m_is_large.assign(n, 0);
+    m_large.clear();
+    size_t total = 0;
+    for (int o = 0; o < n; o++) {
+        cell_range(m_x0[o], m_y0[o], m_x1[o], m_y1[o], m_cx0[o], m_cy0[o], m_cx1[o], m_cy1[o]);
+        long long cells = cell_count(m_cx0[o], m_cy0[o], m_cx1[o], m_cy1[o]);
+        if (cells > MAX_CELLS_PER_OBJECT) {
+            m_is_large[o] = 1;
+            m_large.push_back(o);
+        } else {
+            total += (size_t)cells;
+        }
+    }
+
+    // Twice as many buckets as entries keeps unrelated cells mostly apart.
+    unsigned int buckets = 16;
+    while (buckets < total * 2) buckets <<= 1;
+    m_bucket_mask = buckets - 1;
+
+    // Counting sort by bucket: count, turn the counts into bucket ends, then
+    // fill each bucket backwards so the ends become starts.
+    m_bucket_start.assign(buckets + 1, 0);
+    for (int o = 0; o < n; o++) {
+        if (m_is_large[o]) continue;
+        for (int cy = m_cy0[o]; cy <= m_cy1[o]; cy++)
+            for (int cx = m_cx0[o]; cx <= m_cx1[o]; cx++) m_bucket_start[bucket(cx, cy)]++;
+    }
+    unsigned int end = 0;
+    for (unsigned int b = 0; b < buckets; b++) { end += m_bucket_start[b]; m_bucket_start[b] = end; }
+    m_bucket_start[buckets] = end;
+
+    m_entries.resize(total);
+    for (int o = 0; o < n; o++) {
+        if (m_is_large[o]) continue;
+        for (int cy = m_cy0[o]; cy <= m_cy1[o]; cy++)
+            for (int cx = m_cx0[o]; cx <= m_cx1[o]; cx++)
+                m_entries[--m_bucket_start[bucket(cx, cy)]] = { cx, cy, o };
+    }
+}
+
+bool SpatialHash::overlaps(int a, int b) const {
+    return m_x0[a] <= m_x1[b] && m_x0[b] <= m_x1[a] &&
+           m_y0[a] <= m_y1[b] && m_y0[b] <= m_y1[a];
+}
+
+static CollisionPair make_pair(int a, int b) {
+    return a < b ? CollisionPair{ a, b } : CollisionPair{ b, a };
+}
+
+/*
+@brief, finds every pair of overlapping objects. Two objects in the grid
+        are only compared in the cell holding the top-left corner of their
+        overlap, which both of them cover, so a pair is never reported twice
+        no matter how many cells they share.
+*/
+const std::vector<CollisionPair>& SpatialHash::pairs() {
+    m_pairs.clear();
+    unsigned int buckets = m_bucket_mask + 1;
+    for (unsigned int b = 0; b < buckets && !m_entries.empty(); b++) {
+        unsigned int first = m_bucket_start[b], last = m_bucket_start[b + 1];
+        for (unsigned int i = first; i < last; i++) {
+            const Entry& e = m_entries[i];
+            for (unsigned int j = i + 1; j < last; j++) {
+                const Entry& f = m_entries[j];
+                if (e.cx != f.cx || e.cy != f.cy) continue;  // another cell in the same bucket
+                int a = e.object, c = f.object;
+                if (std::max(m_cx0[a], m_cx0[c]) != e.cx || std::max(m_cy0[a], m_cy0[c]) != e.cy) continue;
+                if (overlaps(a, c)) m_pairs.push_back(make_pair(m_index[a], m_index[c]));
+            }
+        }
+    }
+
+    // Objects too big for the grid are checked against everything; among
+    // themselves only once per pair.
+    int n = (int)m_index.size();
+    for (int l : m_large) {
+        for (int o = 0; o < n; o++) {
+            if (o == l || (m_is_large[o] && o < l)) continue;
+            if (overlaps(l, o)) m_pairs.push_back(make_pair(m_index[l], m_index[o]));
+        }
+    }
+    return m_pairs;
+}
+
+/*
+@brief, collects the objects overlapping a box. Like pairs, an object is
+        only reported from the first cell it shares with the box.
+
+@param x/y/width/height, the box, in the same units as DrawData
+@param out, replaced with the ptr indices of the overlapping objects
+*/
+int SpatialHash::query(float x, float y, float width, float height, std::vector<int>& out) const {
+    out.clear();
+    float x0 = std::min(x, x + width), x1 = std::max(x, x + width);
+    float y0 = std::min(y, y + height), y1 = std::max(y, y + height);
+    auto hit = [&](int o) {
+        return m_x0[o] <= x1 && x0 <= m_x1[o] && m_y0[o] <= y1 && y0 <= m_y1[o];
+    };
+
+    int n = (int)m_index.size();
+    int rx0, ry0, rx1, ry1;
+    cell_range(x0, y0, x1, y1, rx0, ry0, rx1, ry1);
+    if (cell_count(rx0, ry0, rx1, ry1) > n) {
+        // Box covers more cells than there are objects; testing them all is cheaper.
+        for (int o = 0; o < n; o++) if (hit(o)) out.push_back(m_index[o]);
+        return (int)out.size();
+    }
+
+    if (!m_entries.empty()) {
+        for (int cy = ry0; cy <= ry1; cy++) {
+            for (int cx = rx0; cx <= rx1; cx++) {
+                unsigned int b = bucket(cx, cy);
+                for (unsigned int i = m_bucket_start[b]; i < m_bucket_start[b + 1]; i++) {
+                    const Entry& e = m_entries[i];
+                    if (e.cx != cx || e.cy != cy) continue;
+                    int o = e.object;
+                    if (std::max(m_cx0[o], rx0) != cx || std::max(m_cy0[o], ry0) != cy) continue;
+                    if (hit(o)) out.push_back(m_index[o]);
+                }
+            }
+        }
+    }
+    for (int l : m_large) if (hit(l)) out.push_back(m_index[l]);
+    return (int)out.size();
+}
+
+// --- SweepAndPrune -----------------------------------------------------------
+
+static uint64_t pair_key(int a, int b) {
+    if (a > b) std::swap(a, b);
+    return ((uint64_t)(uint32_t)a << 32) | (uint32_t)b;
+}
+
+static CollisionPair key_pair(uint64_t key) {
+    return { (int)(key >> 32), (int)(key & 0xFFFFFFFFu) };
+}
+
+SweepAndPrune::SweepAndPrune() {
+    m_has_removed = false;
+    m_live = 0;
+}
+
+void SweepAndPrune::set_bounds(Proxy& proxy, float x, float y, float width, float height) {
+    proxy.min[0] = std::min(x, x + width);
+    proxy.max[0] = std::max(x, x + width);
+    proxy.min[1] = std::min(y, y + height);
+    proxy.max[1] = std::max(y, y + height);
+}
+
+/* @brief, tracks object from the next update on and returns its proxy id */
+int SweepAndPrune::add(const DrawData* object) {
+    int id = add_box(object->x, object->y, object->width, object->height);
+    m_proxies[id].object = object;
+    return id;
+}
+
+/* @brief, tracks a box that only moves through move_box */
+int SweepAndPrune::add_box(float x, float y, float width, float height) {
+    int id;
+    if (!m_free_ids.empty()) {
+        id = m_free_ids.back();
+        m_free_ids.pop_back();
+    } else {
+        id = (int)m_proxies.size();
+        m_proxies.push_back(Proxy());
+    }
+    Proxy& proxy = m_proxies[id];
+    set_bounds(proxy, x, y, width, height);
+    proxy.object = nullptr;
+    proxy.alive = true;
+    proxy.added = true;
+    proxy.removed = false;
+    m_live++;
+    return id;
+}
+
+void SweepAndPrune::move_box(int id, float x, float y, float width, float height) {
+    set_bounds(m_proxies[id], x, y, width, height);
+}
+
+void SweepAndPrune::remove(int id) {
+    Proxy& proxy = m_proxies[id];
+    if (!proxy.alive) return;
+    proxy.alive = false;
+    m_live--;
+    if (proxy.added) {  // never made it into the lists, nothing to report
+        proxy.added = false;
+        m_free_ids.push_back(id);
+        return;
+    }
+    proxy.removed = true;
+    m_has_removed = true;
+}
+
+/* Records a change to the pair set, remembering the pair's state from before
+this update the first time it is touched. */
+void SweepAndPrune::pair_changed(int a, int b, bool overlap) {
+    uint64_t key = pair_key(a, b);
+    bool was = m_pairs.count(key) != 0;
+    if (was == overlap) return;
+    if (m_touched.insert(key).second) m_before.push_back({ key, was });
+    if (overlap) m_pairs.insert(key);
+    else m_pairs.erase(key);
+}
+
+/*
+@brief, insertion sort of one axis. Ties put min endpoints first, so boxes
+        that touch count as overlapping. Every swap of a min and a max of
+        two boxes is the moment they start or stop overlapping on this axis;
+        a start only becomes a pair if the boxes overlap on the other axis too.
+*/
+void SweepAndPrune::sort_axis(int axis) {
+    std::vector<Endpoint>& list = m_axis[axis];
+    int count = (int)list.size();
+    for (int i = 1; i < count; i++) {
+        Endpoint e = list[i];
+        bool e_max = (e.packed & 1) != 0;
+        int j = i;
+        while (j > 0) {
+            const Endpoint& p = list[j - 1];
+            bool p_max = (p.packed & 1) != 0;
+            if (!(e.value < p.value || (e.value == p.value && !e_max && p_max))) break;
+
+            int a = e.packed >> 1, b = p.packed >> 1;
+            if (!e_max && p_max) {
+                const Proxy& pa = m_proxies[a];
+                const Proxy& pb = m_proxies[b];
+                if (pa.min[0] <= pb.max[0] && pb.min[0] <= pa.max[0] &&
+                    pa.min[1] <= pb.max[1] && pb.min[1] <= pa.max[1]) pair_changed(a, b, true);
+            } else if (e_max && !p_max) {
+                pair_changed(a, b, false);
+            }
+            list[j] = p;
+            j--;
+        }
+        list[j] = e;
+    }
+}
+
+/*
+@brief, re-reads tracked objects, re-sorts both axes and fills began and
+        ended. Removed proxies are dropped first and their pairs reported
+        as ended; new ones are inserted from the end of each list.
+*/
+void SweepAndPrune::update() {
+    m_began.clear();
+    m_ended.clear();
+    m_touched.clear();
+    m_before.clear();
+
+    for (Proxy& proxy : m_proxies) {
+        if (proxy.alive && proxy.object) {
+            const DrawData* d = proxy.object;
+            set_bounds(proxy, d->x, d->y, d->width, d->height);
+        }
+    }
+
+    if (m_has_removed) {
+        for (std::vector<Endpoint>& list : m_axis) {
+            list.erase(std::remove_if(list.begin(), list.end(), [this](const Endpoint& e) {
+                return m_proxies[e.packed >> 1].removed;
+            }), list.end());
+        }
+        for (auto it = m_pairs.begin(); it != m_pairs.end();) {
+            CollisionPair pair = key_pair(*it);
+            if (m_proxies[pair.a].removed || m_proxies[pair.b].removed) {
+                m_ended.push_back(pair);
+                it = m_pairs.erase(it);
+            } else {
+                ++it;
+            }
+        }
+        for (int id = 0; id < (int)m_proxies.size(); id++) {
+            if (!m_proxies[id].removed) continue;
+            m_proxies[id].removed = false;
+            m_free_ids.push_back(id);
+        }
+        m_has_removed = false;
+    }
+
+    for (int axis = 0; axis < 2; axis++) {
+        for (Endpoint& e : m_axis[axis]) {
+            const Proxy& proxy = m_proxies[e.packed >> 1];
+            e.value = (e.packed & 1) ? proxy.max[axis] : proxy.min[axis];
+        }
+    }
+    for (int id = 0; id < (int)m_proxies.size(); id++) {
+        Proxy& proxy = m_proxies[id];
+        if (!proxy.added) continue;
+        proxy.added = false;
+        for (int axis = 0; axis < 2; axis++) {
+            m_axis[axis].push_back({ proxy.min[axis], id << 1 });
+            m_axis[axis].push_back({ proxy.max[axis], (id << 1) | 1 });
+        }
+    }
+
+    sort_axis(0);
+    sort_axis(1);
+
+    for (const std::pair<uint64_t, bool>& change : m_before) {
+        bool now = m_pairs.count(change.first) != 0;
+        if (now && !change.second) m_began.push_back(key_pair(change.first));
+        else if (!now && change.second) m_ended.push_back(key_pair(change.first));
+    }
+}
+
+/* @brief, every pair overlapping as of the last update, sorted */
+void SweepAndPrune::pairs(std::vector<CollisionPair>& out) const {
+    out.clear();
+    for (uint64_t key : m_pairs) out.push_back(key_pair(key));
+    std::sort(out.begin(), out.end(), [](const CollisionPair& x, const CollisionPair& y) {
+        return x.a != y.a ? x.a < y.a : x.b < y.b;
+    });
+}
+
+bool SweepAndPrune::overlapping(int a, int b) const {
+    return a != b && m_pairs.count(pair_key(a, b)) != 0;
+}
+
+// --- AabbTree ----------------------------------------------------------------
+
+AabbTree::AabbTree(float margin) {
+    m_root = -1;
+    m_free = -1;
+    m_leaves = 0;
+    m_margin = margin;
+}
+
+int AabbTree::alloc_node() {
+    int id;
+    if (m_free >= 0) {
+        id = m_free;
+        m_free = m_nodes[id].parent;
+    } else {
+        id = (int)m_nodes.size();
+        m_nodes.push_back(Node());
+    }
+    Node& node = m_nodes[id];
+    node.object = nullptr;
+    node.user = nullptr;
+    node.parent = node.child1 = node.child2 = -1;
+    node.height = 0;
+    return id;
+}
+
+void AabbTree::free_node(int id) {
+    m_nodes[id].height = -1;
+    m_nodes[id].parent = m_free;
+    m_free = id;
+}
+
+void AabbTree::clear() {
+    m_nodes.clear();
+    m_root = -1;
+    m_free = -1;
+    m_leaves = 0;
+}
+
+void AabbTree::set_tight(Node& node, float x, float y, float width, float height) {
+    node.tight[0] = std::min(x, x + width);
+    node.tight[1] = std::min(y, y + height);
+    node.tight[2] = std::max(x, x + width);
+    node.tight[3] = std::max(y, y + height);
+}
+
+void AabbTree::fatten(Node& node) {
+    float grow = m_margin * std::max(node.tight[2] - node.tight[0], node.tight[3] - node.tight[1]);
+    node.min[0] = node.tight[0] - grow;
+    node.min[1] = node.tight[1] - grow;
+    node.max[0] = node.tight[2] + grow;
+    node.max[1] = node.tight[3] + grow;
+}
+
+static float perimeter(const float* mn, const float* mx) {
+    return 2.0f * ((mx[0] - mn[0]) + (mx[1] - mn[1]));
+}
+
+static float union_perimeter(const float* amin, const float* amax, const float* bmin, const float* bmax) {
+    float mn[2] = { std::min(amin[0], bmin[0]), std::min(amin[1], bmin[1]) };
+    float mx[2] = { std::max(amax[0], bmax[0]), std::max(amax[1], bmax[1]) };
+    return perimeter(mn, mx);
+}
+
+/* @brief, recomputes an internal node's box and height from its children */
+void AabbTree::refit(int index) {
+    Node& node = m_nodes[index];
+    const Node& a = m_nodes[node.child1];
+    const Node& b = m_nodes[node.child2];
+    for (int axis = 0; axis < 2; axis++) {
+        node.min[axis] = std::min(a.min[axis], b.min[axis]);
+        node.max[axis] = std::max(a.max[axis], b.max[axis]);
+    }
+    node.height = 1 + std::max(a.height, b.height);
+}
+
+/*
+@brief, finds the sibling whose enlargement costs the least perimeter,
+        descending only while a child is cheaper than pairing with the
+        current node, then pairs the leaf with it and refits and rotates
+        on the way back up.
+*/
+void AabbTree::insert_leaf(int leaf) {
+    m_leaves++;
+    if (m_root < 0) {
+        m_root = leaf;
+        m_nodes[leaf].parent = -1;
+        return;
+    }
+
+    const float* lmin = m_nodes[leaf].min;
+    const float* lmax = m_nodes[leaf].max;
+    int index = m_root;
+    while (m_nodes[index].height > 0) {
+        const Node& node = m_nodes[index];
+        float area = perimeter(node.min, node.max);
+        float combined = union_perimeter(node.min, node.max, lmin, lmax);
+        float cost = 2.0f * combined;                  // pair with this node
+        float inheritance = 2.0f * (combined - area);  // growth pushed onto ancestors
+
+        float child_cost[2];
+        int children[2] = { node.child1, node.child2 };
+        for (int c = 0; c < 2; c++) {
+            const Node& child = m_nodes[children[c]];
+            float grown = union_perimeter(child.min, child.max, lmin, lmax);
+            child_cost[c] = (child.height == 0 ? grown : grown - perimeter(child.min, child.max)) + inheritance;
+        }
+        if (cost < child_cost[0] && cost < child_cost[1]) break;
+        index = child_cost[0] < child_cost[1] ? children[0] : children[1];
+    }
+
+    int sibling = index;
+    int old_parent = m_nodes[sibling].parent;
+    int parent = alloc_node();  // may grow m_nodes, so no references held across it
+    m_nodes[parent].parent = old_parent;
+    m_nodes[parent].child1 = sibling;
+    m_nodes[parent].child2 = leaf;
+    m_nodes[sibling].parent = parent;
+    m_nodes[leaf].parent = parent;
+    if (old_parent < 0) m_root = parent;
+    else if (m_nodes[old_parent].child1 == sibling) m_nodes[old_parent].child1 = parent;
+    else m_nodes[old_parent].child2 = parent;
+
+    for (index = parent; index >= 0; index = m_nodes[index].parent) {
+        refit(index);
+        rotate(index);
+        refit(index);
+    }
+}
+
+void AabbTree::remove_leaf(int leaf) {
+    m_leaves--;
+    if (leaf == m_root) {
+        m_root = -1;
+        return;
+    }
+
+    int parent = m_nodes[leaf].parent;
+    int grand = m_nodes[parent].parent;
+    int sibling = m_nodes[parent].child1 == leaf ? m_nodes[parent].child2 : m_nodes[parent].child1;
+    free_node(parent);
+
+    if (grand < 0) {
+        m_root = sibling;
+        m_nodes[sibling].parent = -1;
+        return;
+    }
+    if (m_nodes[grand].child1 == parent) m_nodes[grand].child1 = sibling;
+    else m_nodes[grand].child2 = sibling;
+    m_nodes[sibling].parent = grand;
+
+    for (int index = grand; index >= 0; index = m_nodes[index].parent) {
+        refit(index);
+        rotate(index);
+        refit(index);
+    }
+}
+
+/*
+@brief, swaps a child of index with a grandchild on the other side, or two
+        grandchildren, when that shrinks the perimeter of index's children.
+        Done on every node on the way up from an insert or remove, this
+        keeps sibling boxes from overlapping much, which is what queries
+        pay for.
+*/
+void AabbTree::rotate(int index) {
+    const Node& a = m_nodes[index];
+    if (a.height < 2) return;
+    int ib = a.child1, ic = a.child2;
+    const Node& b = m_nodes[ib];
+    const Node& c = m_nodes[ic];
+    auto node_perimeter = [this](int n) { return perimeter(m_nodes[n].min, m_nodes[n].max); };
+    auto joined = [this](int n, int m) {
+        return union_perimeter(m_nodes[n].min, m_nodes[n].max, m_nodes[m].min, m_nodes[m].max);
+    };
+
+    enum { NONE, B_F, B_G, C_D, C_E, D_F, D_G } best = NONE;
+    float best_cost = 0.0f;  // change in perimeter, only improvements count
+    auto consider = [&](int option, float cost) {
+        if (cost < best_cost) { best_cost = cost; best = (decltype(best))option; }
+    };
+    int id = -1, ie = -1, iff = -1, ig = -1;
+    if (c.height > 0) {
+        iff = c.child1; ig = c.child2;
+        float pc = node_perimeter(ic);
+        consider(B_F, joined(ib, ig) - pc);
+        consider(B_G, joined(ib, iff) - pc);
+    }
+    if (b.height > 0) {
+        id = b.child1; ie = b.child2;
+        float pb = node_perimeter(ib);
+        consider(C_D, joined(ic, ie) - pb);
+        consider(C_E, joined(ic, id) - pb);
+    }
+    if (b.height > 0 && c.height > 0) {
+        float both = node_perimeter(ib) + node_perimeter(ic);
+        consider(D_F, joined(iff, ie) + joined(id, ig) - both);
+        consider(D_G, joined(ig, ie) + joined(iff, id) - both);
+    }
+
+    auto swap_in = [this](int parent, int old_child, int new_child) {
+        Node& p = m_nodes[parent];
+        if (p.child1 == old_child) p.child1 = new_child;
+        else p.child2 = new_child;
+        m_nodes[new_child].parent = parent;
+    };
+    switch (best) {
+    case NONE: return;
+    case B_F: swap_in(index, ib, iff); swap_in(ic, iff, ib); refit(ic); break;
+    case B_G: swap_in(index, ib, ig);  swap_in(ic, ig, ib);  refit(ic); break;
+    case C_D: swap_in(index, ic, id);  swap_in(ib, id, ic);  refit(ib); break;
+    case C_E: swap_in(index, ic, ie);  swap_in(ib, ie, ic);  refit(ib); break;
+    case D_F: swap_in(ib, id, iff); swap_in(ic, iff, id); refit(ib); refit(ic); break;
+    case D_G: swap_in(ib, id, ig);  swap_in(ic, ig, id);  refit(ib); refit(ic); break;
+    }
+}
+
+/* @brief, tracks object (re-read by update) and returns its proxy id */
+int AabbTree::add(const DrawData* object, void* user) {
+    int id = add_box(object->x, object->y, object->width, object->height, user);
+    m_nodes[id].object = object;
+    return id;
+}
+
+int AabbTree::add_box(float x, float y, float width, float height, void* user) {
+    int id = alloc_node();
+    Node& node = m_nodes[id];
+    node.user = user;
+    set_tight(node, x, y, width, height);
+    fatten(node);
+    insert_leaf(id);
+    return id;
+}
+
+bool AabbTree::move_box(int id, float x, float y, float width, float height) {
+    Node& node = m_nodes[id];
+    set_tight(node, x, y, width, height);
+    if (node.tight[0] >= node.min[0] && node.tight[1] >= node.min[1] &&
+        node.tight[2] <= node.max[0] && node.tight[3] <= node.max[1]) return false;
+
+    remove_leaf(id);
+    fatten(m_nodes[id]);
+    insert_leaf(id);
+    return true;
+}
+
+void AabbTree::remove(int id) {
+    if (id < 0 || id >= (int)m_nodes.size() || m_nodes[id].height != 0) return;
+    remove_leaf(id);
+    free_node(id);
+}
+
+void AabbTree::update() {
+    for (int id = 0; id < (int)m_nodes.size(); id++) {
+        const Node& node = m_nodes[id];
+        if (node.height != 0 || !node.object) continue;
+        const DrawData* d = node.object;
+        move_box(id, d->x, d->y, d->width, d->height);
+    }
+}
+
+int AabbTree::query_point(float x, float y, std::vector<int>& out) const {
+    out.clear();
+    if (m_root < 0) return 0;
+    m_stack.clear();
+    m_stack.push_back(m_root);
+    while (!m_stack.empty()) {
+        int index = m_stack.back();
+        m_stack.pop_back();
+        const Node& node = m_nodes[index];
+        if (x < node.min[0] || x > node.max[0] || y < node.min[1] || y > node.max[1]) continue;
+        if (node.height == 0) {
+            if (x >= node.tight[0] && x <= node.tight[2] && y >= node.tight[1] && y <= node.tight[3])
+                out.push_back(index);
+        } else {
+            m_stack.push_back(node.child1);
+            m_stack.push_back(node.child2);
+        }
+    }
+    return (int)out.size();
+}
+
+int AabbTree::query_region(float x, float y, float width, float height, std::vector<int>& out) const {
+    out.clear();
+    if (m_root < 0) return 0;
+    float x0 = std::min(x, x + width), x1 = std::max(x, x + width);
+    float y0 = std::min(y, y + height), y1 = std::max(y, y + height);
+    m_stack.clear();
+    m_stack.push_back(m_root);
+    while (!m_stack.empty()) {
+        int index = m_stack.back();
+        m_stack.pop_back();
+        const Node& node = m_nodes[index];
+        if (node.min[0] > x1 || x0 > node.max[0] || node.min[1] > y1 || y0 > node.max[1]) continue;
+        if (node.height == 0) {
+            if (node.tight[0] <= x1 && x0 <= node.tight[2] && node.tight[1] <= y1 && y0 <= node.tight[3])
+                out.push_back(index);
+        } else {
+            m_stack.push_back(node.child1);
+            m_stack.push_back(node.child2);
+        }
+    }
+    return (int)out.size();
+}
+
+/* Slab test. Returns the entry t in [0, max_t], or -1 on a miss; a ray
+starting inside the box enters at 0. */
+static float ray_box(float ox, float oy, float dx, float dy, float max_t,
+                     float x0, float y0, float x1, float y1) {
+    float t0 = 0.0f, t1 = max_t;
+    const float o[2] = { ox, oy }, d[2] = { dx, dy };
+    const float lo[2] = { x0, y0 }, hi[2] = { x1, y1 };
+    for (int axis = 0; axis < 2; axis++) {
+        if (d[axis] == 0.0f) {
+            if (o[axis] < lo[axis] || o[axis] > hi[axis]) return -1.0f;
+            continue;
+        }
+        float inv = 1.0f / d[axis];
+        float t_near = (lo[axis] - o[axis]) * inv, t_far = (hi[axis] - o[axis]) * inv;
+        if (t_near > t_far) std::swap(t_near, t_far);
+        t0 = std::max(t0, t_near);
+        t1 = std::min(t1, t_far);
+        if (t0 > t1) return -1.0f;
+    }
+    return t0;
+}
+
+/*
+@brief, finds the first proxy the ray enters. Subtrees whose fat box the
+        ray reaches later than the best hit so far are skipped.
+
+@param ox/oy, ray origin
+@param dx/dy, ray direction; t is measured in multiples of it
+@param max_t, ignore hits further than this
+*/
+RayHit AabbTree::raycast(float ox, float oy, float dx, float dy, float max_t) const {
+    RayHit hit = { -1, max_t, 0.0f, 0.0f };
+    if (m_root < 0) return hit;
+    m_stack.clear();
+    m_stack.push_back(m_root);
+    while (!m_stack.empty()) {
+        int index = m_stack.back();
+        m_stack.pop_back();
+        const Node& node = m_nodes[index];
+        if (ray_box(ox, oy, dx, dy, hit.t, node.min[0], node.min[1], node.max[0], node.max[1]) < 0.0f) continue;
+        if (node.height == 0) {
+            float t = ray_box(ox, oy, dx, dy, hit.t, node.tight[0], node.tight[1], node.tight[2], node.tight[3]);
+            if (t >= 0.0f && (hit.id < 0 || t < hit.t)) { hit.id = index; hit.t = t; }
+        } else {
+            m_stack.push_back(node.child1);
+            m_stack.push_back(node.child2);
+        }
+    }
+    if (hit.id >= 0) {
+        hit.x = ox + hit.t * dx;
+        hit.y = oy + hit.t * dy;
+    }
+    return hit;
+}
+
+// --- Bulk box tests ----------------------------------------------------------
+
+static void soa_resize(BoxSoA& out, int count) {
+    out.min_x.resize(count);
+    out.min_y.resize(count);
+    out.max_x.resize(count);
+    out.max_y.resize(count);
+    out.count = count;
+}
+
+static void soa_set(BoxSoA& out, int i, float x, float y, float width, float height) {
+    out.min_x[i] = std::min(x, x + width);
+    out.max_x[i] = std::max(x, x + width);
+    out.min_y[i] = std::min(y, y + height);
+    out.max_y[i] = std::max(y, y + height);
+}
+
+/* @brief, bounds of ptr[0..count); NaN bounds for nullptr, which fail every comparison */
+void aabb_from_objects(void** ptr, int count, BoxSoA& out) {
+    soa_resize(out, count);
+    const float nan = std::numeric_limits<float>::quiet_NaN();
+    for (int i = 0; i < count; i++) {
+        const DrawData* d = (const DrawData*)ptr[i];
+        if (d) soa_set(out, i, d->x, d->y, d->width, d->height);
+        else out.min_x[i] = out.min_y[i] = out.max_x[i] = out.max_y[i] = nan;
+    }
+}
+
+void aabb_from_soa(const DrawSoA& objects, BoxSoA& out) {
+    soa_resize(out, objects.count);
+    for (int i = 0; i < objects.count; i++)
+        soa_set(out, i, objects.x[i], objects.y[i], objects.width[i], objects.height[i]);
+}
+
+// The query box, and the test every path implements: the same four ordered
+// <= comparisons, so NaN and signed zeros come out the same everywhere.
+struct AabbQuery { float min_x, min_y, max_x, max_y; };
+
+static inline uint32_t overlap_bit(const AabbQuery& q, const BoxSoA& b, int i) {
+    return (uint32_t)((q.min_x <= b.max_x[i]) & (b.min_x[i] <= q.max_x) &
+                      (q.min_y <= b.max_y[i]) & (b.min_y[i] <= q.max_y));
+}
+
+/* Each path fills every word of mask for boxes [0, b.count). */
+static void overlap_scalar(const AabbQuery& q, const BoxSoA& b, uint32_t* mask) {
+    for (int base = 0; base < b.count; base += 32) {
+        int n = std::min(32, b.count - base);
+        uint32_t bits = 0;
+        for (int i = 0; i < n; i++) bits |= overlap_bit(q, b, base + i) << i;
+        mask[base / 32] = bits;
+    }
+}
+
+#ifdef AABB_X86
+static void overlap_sse2(const AabbQuery& q, const BoxSoA& b, uint32_t* mask) {
+    const __m128 qx0 = _mm_set1_ps(q.min_x), qy0 = _mm_set1_ps(q.min_y);
+    const __m128 qx1 = _mm_set1_ps(q.max_x), qy1 = _mm_set1_ps(q.max_y);
+    const float *x0 = b.min_x.data(), *y0 = b.min_y.data(), *x1 = b.max_x.data(), *y1 = b.max_y.data();
+    for (int base = 0; base < b.count; base += 32) {
+        int n = std::min(32, b.count - base);
+        uint32_t bits = 0;
+        int i = 0;
+        for (; i + 4 <= n; i += 4) {
+            int k = base + i;
+            __m128 hit = _mm_and_ps(_mm_cmple_ps(qx0, _mm_loadu_ps(x1 + k)), _mm_cmple_ps(_mm_loadu_ps(x0 + k), qx1));
+            hit = _mm_and_ps(hit, _mm_cmple_ps(qy0, _mm_loadu_ps(y1 + k)));
+            hit = _mm_and_ps(hit, _mm_cmple_ps(_mm_loadu_ps(y0 + k), qy1));
+            bits |= (uint32_t)_mm_movemask_ps(hit) << i;
+        }
+        for (; i < n; i++) bits |= overlap_bit(q, b, base + i) << i;
+        mask[base / 32] = bits;
+    }
+}
+
+#if defined(__GNUC__) || defined(__clang__)
+  #define AABB_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+  #define AABB_TARGET_AVX2
+#endif
+
+// _CMP_LE_OQ is the ordered, quiet <=, the same predicate as the scalar and
+// SSE2 comparisons.
+AABB_TARGET_AVX2 static void overlap_avx2(const AabbQuery& q, const BoxSoA& b, uint32_t* mask) {
+    const __m256 qx0 = _mm256_set1_ps(q.min_x), qy0 = _mm256_set1_ps(q.min_y);
+    const __m256 qx1 = _mm256_set1_ps(q.max_x), qy1 = _mm256_set1_ps(q.max_y);
+    const float *x0 = b.min_x.data(), *y0 = b.min_y.data(), *x1 = b.max_x.data(), *y1 = b.max_y.data();
+    for (int base = 0; base < b.count; base += 32) {
+        int n = std::min(32, b.count - base);
+        uint32_t bits = 0;
+        int i = 0;
+        for (; i + 8 <= n; i += 8) {
+            int k = base + i;
+            __m256 hit = _mm256_and_ps(_mm256_cmp_ps(qx0, _mm256_loadu_ps(x1 + k), _CMP_LE_OQ),
+                                       _mm256_cmp_ps(_mm256_loadu_ps(x0 + k), qx1, _CMP_LE_OQ));
+            hit = _mm256_and_ps(hit, _mm256_cmp_ps(qy0, _mm256_loadu_ps(y1 + k), _CMP_LE_OQ));
+            hit = _mm256_and_ps(hit, _mm256_cmp_ps(_mm256_loadu_ps(y0 + k), qy1, _CMP_LE_OQ));
+            bits |= (uint32_t)_mm256_movemask_ps(hit) << i;
+        }
+        for (; i < n; i++) bits |= overlap_bit(q, b, base + i) << i;
+        mask[base / 32] = bits;
+    }
+}
+
+static bool cpu_has_avx2() {
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+#elif defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7) return false;
+    __cpuid(info, 1);
+    bool osxsave = (info[2] & (1 << 27)) != 0, avx = (info[2] & (1 << 28)) != 0;
+    if (!osxsave || !avx || (_xgetbv(0) & 6) != 6) return false;  // OS must save YMM registers
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    return false;
+#endif
+}
+#endif
+
+static AabbSimd best_simd() {
+#ifdef AABB_X86
+    static const AabbSimd best = cpu_has_avx2() ? AabbSimd::AVX2 : AabbSimd::SSE2;
+    return best;
+#else
+    return AabbSimd::Scalar;
+#endif
+}
+
+static AabbSimd aabb_path = best_simd();
+
+void aabb_set_simd(AabbSimd path) { aabb_path = std::min(path, best_simd()); }
+AabbSimd aabb_simd() { return aabb_path; }
+
+static void overlap_dispatch(const AabbQuery& q, const BoxSoA& b, uint32_t* mask) {
+    switch (aabb_path) {
+#ifdef AABB_X86
+    case AabbSimd::AVX2: overlap_avx2(q, b, mask); return;
+    case AabbSimd::SSE2: overlap_sse2(q, b, mask); return;
+#endif
+    default: overlap_scalar(q, b, mask); return;
+    }
+}
+
+static int bit_count(uint32_t v) {
+    v = v - ((v >> 1) & 0x55555555u);
+    v = (v & 0x33333333u) + ((v >> 2) & 0x33333333u);
+    return (int)((((v + (v >> 4)) & 0x0F0F0F0Fu) * 0x01010101u) >> 24);
+}
+
+/*
+@brief, tests one box against every box in boxes
+
+@param min_x/min_y/max_x/max_y, the box
+@param boxes, the boxes to test against
+@param mask, aabb_mask_words(boxes.count) words; bit i is set if boxes[i] overlaps
+*/
+int aabb_overlap_mask(float min_x, float min_y, float max_x, float max_y,
+                      const BoxSoA& boxes, uint32_t* mask) {
+    overlap_dispatch({ min_x, min_y, max_x, max_y }, boxes, mask);
+    int hits = 0;
+    for (int w = 0; w < aabb_mask_words(boxes.count); w++) hits += bit_count(mask[w]);
+    return hits;
+}
+
+/*
+@brief, tests every box of a against every box of b. Row i of masks, at
+        masks + i * aabb_mask_words(b.count), is the mask for a's box i.
+*/
+void aabb_overlap_masks(const BoxSoA& a, const BoxSoA& b, uint32_t* masks) {
+    int words = aabb_mask_words(b.count);
+    for (int i = 0; i < a.count; i++) {
+        AabbQuery q = { a.min_x[i], a.min_y[i], a.max_x[i], a.max_y[i] };
+        overlap_dispatch(q, b, masks + (size_t)i * words);
+    }
+}
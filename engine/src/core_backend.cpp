@@ -0,0 +1,234 @@
+// Copyright (c) 2026- b0owl / Brennan Marx-Rennie. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to use,
+// copy, modify, and distribute the Software for NON-COMMERCIAL purposes only,
+// subject to the following conditions:
+//
+// 1. The above copyright notice and this permission notice shall be included
+//    in all copies or substantial portions of the Software.
+// 2. The Software may not be used for commercial purposes without prior
+//    written permission from the copyright holder.
+// 3. Commercial use includes, but is not limited to, selling the Software,
+//    using it in a commercial product, or using it to provide commercial services.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+
+#include <GLFW/glfw3.h>
+#include <stdio.h>
+#include "../include/rendering.h"
+#include "../include/batch.h"
+#include "../include/gl_state.h"
+#include "gl_functions.h"
+#include "core_backend.h"
+
+enum { CORE_ATTR_POS = 0, CORE_ATTR_UV = 1, CORE_ATTR_COLOR = 2 };
+
+struct CoreProgram {
+    GLuint id;
+    GLint u_proj, u_offset;
+    unsigned int proj_version;   // core_projection_version last uploaded
+    float offset_x, offset_y;    // u_offset last uploaded
+};
+
+static RenderBackend requested_backend = RenderBackend::Auto;
+static int core_state = -1;  // -1 unresolved, 0 legacy, 1 core
+static bool null_backend = false;
+
+static float core_projection[16] = {
+    1, 0, 0, 0,
+    0, 1, 0, 0,
+    0, 0, 1, 0,
+    0, 0, 0, 1,
+};
+static unsigned int core_projection_version = 1;
+
+static CoreProgram core_sprite_program;
+static CoreProgram core_sdf_program;
+static GLuint core_sprite_vao = 0, core_sprite_vbo = 0;
+static GLuint core_scratch_vao = 0;  // for draws that set their own pointers
+
+static const char* CORE_SPRITE_VS =
+    "#version 330 core\n"
+    "in vec2 a_pos;\n"
+    "in vec2 a_uv;\n"
+    "in vec4 a_color;\n"
+    "uniform mat4 u_proj;\n"
+    "uniform vec2 u_offset;\n"
+    "out vec2 v_uv;\n"
+    "out vec4 v_color;\n"
+    "void main() {\n"
+    "    v_uv = a_uv;\n"
+    "    v_color = a_color;\n"
+    "    gl_Position = u_proj * vec4(a_pos + u_offset, 0.0, 1.0);\n"
+    "}\n";
+
+static const char* CORE_SPRITE_FS =
+    "#version 330 core\n"
+    "uniform sampler2D u_tex;\n"
+    "in vec2 v_uv;\n"
+    "in vec4 v_color;\n"
+    "out vec4 frag_color;\n"
+    "void main() {\n"
+    "    frag_color = texture(u_tex, v_uv) * v_color;\n"
+    "}\n";
+
+// Same edge reconstruction as the legacy SDF shader in sdf_text.cpp.
+static const char* CORE_SDF_FS =
+    "#version 330 core\n"
+    "uniform sampler2D u_tex;\n"
+    "in vec2 v_uv;\n"
+    "in vec4 v_color;\n"
+    "out vec4 frag_color;\n"
+    "void main() {\n"
+    "    float d = texture(u_tex, v_uv).a;\n"
+    "    float w = max(fwidth(d), 0.0001);\n"
+    "    float a = smoothstep(0.5 - w, 0.5 + w, d);\n"
+    "    frag_color = vec4(v_color.rgb, v_color.a * a);\n"
+    "}\n";
+
+static bool build_core_program(CoreProgram& program, const char* fs) {
+    const char* attribs[] = { "a_pos", "a_uv", "a_color" };
+    program.id = gl_build_program(CORE_SPRITE_VS, fs, attribs, 3);
+    if (!program.id) return false;
+    program.u_proj = bgl.GetUniformLocation(program.id, "u_proj");
+    program.u_offset = bgl.GetUniformLocation(program.id, "u_offset");
+    program.proj_version = 0;
+    program.offset_x = program.offset_y = 0.0f;
+    gls_use_program(program.id);
+    bgl.Uniform1i(bgl.GetUniformLocation(program.id, "u_tex"), 0);
+    bgl.Uniform2f(program.u_offset, 0.0f, 0.0f);
+    return true;
+}
+
+static bool core_init() {
+    if (!gl_has_shaders() || !gl_has_vertex_arrays()) return false;
+    if (!build_core_program(core_sprite_program, CORE_SPRITE_FS)) return false;
+    if (!build_core_program(core_sdf_program, CORE_SDF_FS)) return false;
+
+    // The sprite VAO's pointers never change; only the buffer contents do.
+    bgl.GenVertexArrays(1, &core_sprite_vao);
+    bgl.GenVertexArrays(1, &core_scratch_vao);
+    bgl.GenBuffers(1, &core_sprite_vbo);
+    gls_bind_vertex_array(core_sprite_vao);
+    bgl.BindBuffer(GL_ARRAY_BUFFER, core_sprite_vbo);
+    bgl.EnableVertexAttribArray(CORE_ATTR_POS);
+    bgl.EnableVertexAttribArray(CORE_ATTR_UV);
+    bgl.EnableVertexAttribArray(CORE_ATTR_COLOR);
+    bgl.VertexAttribPointer(CORE_ATTR_POS,   2, GL_FLOAT, GL_FALSE, sizeof(BatchVertex), (const void*)offsetof(BatchVertex, x));
+    bgl.VertexAttribPointer(CORE_ATTR_UV,    2, GL_FLOAT, GL_FALSE, sizeof(BatchVertex), (const void*)offsetof(BatchVertex, u));
+    bgl.VertexAttribPointer(CORE_ATTR_COLOR, 4, GL_FLOAT, GL_FALSE, sizeof(BatchVertex), (const void*)offsetof(BatchVertex, r));
+    bgl.BindBuffer(GL_ARRAY_BUFFER, 0);
+    return true;
+}
+
+/*
+@brief, resolves the backend on first use, once a context is current.
+        A core context that can't run the core renderer is reported, and the
+        legacy path is used (which draws nothing on such a context).
+*/
+bool core_backend_active() {
+    if (core_state >= 0) return core_state == 1;
+    if (null_backend_active() || !glfwGetCurrentContext()) return false;
+
+    bool want_core = requested_backend == RenderBackend::Core ||
+                     (requested_backend == RenderBackend::Auto && gl_core_context());
+    core_state = 0;
+    if (want_core) {
+        if (core_init()) core_state = 1;
+        else fprintf(stderr, "[bytee] GL 3.3 core renderer unavailable, using the legacy path\n");
+    }
+    return core_state == 1;
+}
+
+/*
+@brief, selects the GL path for draw_* calls. Call before the first draw;
+        the choice is made once, when drawing starts.
+*/
+void set_render_backend(RenderBackend backend) {
+    requested_backend = backend;
+}
+
+bool null_backend_active() {
+    return null_backend || requested_backend == RenderBackend::Null;
+}
+
+void backend_use_null() {
+    null_backend = true;
+}
+
+/* @brief, returns Legacy, Core or Null once drawing has started, otherwise the requested backend */
+RenderBackend get_render_backend() {
+    if (null_backend_active()) return RenderBackend::Null;
+    if (core_state < 0 && !glfwGetCurrentContext()) return requested_backend;
+    return core_backend_active() ? RenderBackend::Core : RenderBackend::Legacy;
+}
+
+void backend_set_ortho(float left, float right, float bottom, float top) {
+    // Column-major glOrtho with near -1, far 1.
+    float m[16] = {
+        2.0f / (right - left), 0, 0, 0,
+        0, 2.0f / (top - bottom), 0, 0,
+        0, 0, -1.0f, 0,
+        -(right + left) / (right - left), -(top + bottom) / (top - bottom), 0, 1,
+    };
+    for (int i = 0; i < 16; i++) core_projection[i] = m[i];
+    core_projection_version++;
+
+    if (!null_backend_active() && !gl_core_context()) {
+        glMatrixMode(GL_PROJECTION);
+        glLoadMatrixf(core_projection);
+        glMatrixMode(GL_MODELVIEW);
+        glLoadIdentity();
+    }
+}
+
+void core_apply_projection(int location, unsigned int& version) {
+    if (version == core_projection_version) return;
+    bgl.UniformMatrix4fv(location, 1, GL_FALSE, core_projection);
+    version = core_projection_version;
+}
+
+/* @brief, binds program and brings its core_projection and offset up to date */
+static void use_core_program(CoreProgram& program, float offset_x, float offset_y) {
+    gls_use_program(program.id);
+    core_apply_projection(program.u_proj, program.proj_version);
+    if (program.offset_x != offset_x || program.offset_y != offset_y) {
+        bgl.Uniform2f(program.u_offset, offset_x, offset_y);
+        program.offset_x = offset_x;
+        program.offset_y = offset_y;
+    }
+}
+
+void core_begin_sprites(const BatchVertex* vertices, int count) {
+    gls_bind_vertex_array(core_sprite_vao);
+    bgl.BindBuffer(GL_ARRAY_BUFFER, core_sprite_vbo);
+    // A fresh data store every flush lets the driver orphan the old one
+    // instead of waiting for the GPU to finish reading it.
+    bgl.BufferData(GL_ARRAY_BUFFER, count * sizeof(BatchVertex), vertices, GL_STREAM_DRAW);
+    bgl.BindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void core_use_sprite_shader(int shader) {
+    use_core_program(shader == BATCH_SHADER_SDF ? core_sdf_program : core_sprite_program, 0.0f, 0.0f);
+}
+
+void core_draw_text_mesh(const TextMesh& mesh, float x, float y, float r, float g, float b) {
+    if (!mesh.vbo) return;
+
+    use_core_program(mesh.sdf ? core_sdf_program : core_sprite_program, x, y);
+    gls_bind_vertex_array(core_scratch_vao);
+    bgl.BindBuffer(GL_ARRAY_BUFFER, mesh.vbo);
+    bgl.EnableVertexAttribArray(CORE_ATTR_POS);
+    bgl.EnableVertexAttribArray(CORE_ATTR_UV);
+    bgl.VertexAttribPointer(CORE_ATTR_POS, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (const void*)0);
+    bgl.VertexAttribPointer(CORE_ATTR_UV,  2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (const void*)(2 * sizeof(float)));
+    bgl.DisableVertexAttribArray(CORE_ATTR_COLOR);  // constant color for the whole mesh
+    bgl.VertexAttrib4f(CORE_ATTR_COLOR, r, g, b, 1.0f);
+    bgl.BindBuffer(GL_ARRAY_BUFFER, 0);
+
+    glDrawArrays(GL_TRIANGLES, 0, mesh.vertex_count);
+    gls_count_draw(mesh.vertex_count);
+}
@@ -0,0 +1,49 @@
+// Copyright (c) 2026- b0owl / Brennan Marx-Rennie. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to use,
+// copy, modify, and distribute the Software for NON-COMMERCIAL purposes only,
+// subject to the following conditions:
+//
+// 1. The above copyright notice and this permission notice shall be included
+//    in all copies or substantial portions of the Software.
+// 2. The Software may not be used for commercial purposes without prior
+//    written permission from the copyright holder.
+// 3. Commercial use includes, but is not limited to, selling the Software,
+//    using it in a commercial product, or using it to provide commercial services.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+
+#pragma once
+
+// Internal to the engine: the GL 3.3 core-profile renderer. Draw paths ask
+// core_backend_active() and hand their vertices here instead of using
+// fixed-function state. The projection lives in a uniform that every core
+// program picks up the next time it is bound.
+
+struct BatchVertex;
+struct TextMesh;
+
+bool core_backend_active();
+
+// The null renderer: draw paths count their draws and return before touching
+// GL, and texture uploads are skipped. Forced with RenderBackend::Null, or
+// switched on by a headless window that has no context.
+bool null_backend_active();
+void backend_use_null();
+
+// Sets the 2D projection for both backends. On contexts that still have the
+// fixed-function pipeline the GL matrices are set too, so raw GL keeps working.
+void backend_set_ortho(float left, float right, float bottom, float top);
+
+// Sprite batch: upload the frame's vertices once, then pick the program per run.
+void core_begin_sprites(const BatchVertex* vertices, int count);
+void core_use_sprite_shader(int shader);
+
+void core_draw_text_mesh(const TextMesh& mesh, float x, float y, float r, float g, float b);
+
+// For other core programs (instanced shapes): uploads the projection into
+// `location` if it changed since `version` was last updated.
+void core_apply_projection(int location, unsigned int& version);
@@ -0,0 +1,188 @@
+// Copyright (c) 2026- b0owl / Brennan Marx-Rennie. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to use,
+// copy, modify, and distribute the Software for NON-COMMERCIAL purposes only,
+// subject to the following conditions:
+//
+// 1. The above copyright notice and this permission notice shall be included
+//    in all copies or substantial portions of the Software.
+// 2. The Software may not be used for commercial purposes without prior
+//    written permission from the copyright holder.
+// 3. Commercial use includes, but is not limited to, selling the Software,
+//    using it in a commercial product, or using it to provide commercial services.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+
+#include <GLFW/glfw3.h>
+#include <stdio.h>
+#include "gl_functions.h"
+
+GLFunctions bgl = {};
+
+static bool gl_loaded       = false;
+static bool gl_shaders_ok   = false;
+static bool gl_instancing_ok = false;
+static bool gl_vao_ok       = false;
+static bool gl_timer_ok     = false;
+static bool gl_mipmap_ok    = false;
+static bool gl_auto_mipmap  = false;
+static bool gl_swizzle_ok   = false;
+static bool gl_core         = false;
+
+// Resolves `name`, falling back to the ARB-suffixed name from the extension
+// that introduced it (e.g. glVertexAttribDivisorARB on 2.1 contexts).
+template<typename T>
+static bool load(T& fn, const char* name, const char* arb_name = nullptr) {
+    fn = (T)glfwGetProcAddress(name);
+    if (!fn && arb_name) fn = (T)glfwGetProcAddress(arb_name);
+    return fn != nullptr;
+}
+
+/*
+@brief, resolves every entry point in `bgl` for the current context. Cheap to
+        call repeatedly; the lookup only happens once.
+
+@returns true if shader support is available
+*/
+bool gl_load_functions() {
+    if (gl_loaded) return gl_shaders_ok;
+    if (!glfwGetCurrentContext()) return false;
+    gl_loaded = true;
+
+    bool ok = true;
+    ok &= load(bgl.GenBuffers,    "glGenBuffers");
+    ok &= load(bgl.DeleteBuffers, "glDeleteBuffers");
+    ok &= load(bgl.BindBuffer,    "glBindBuffer");
+    ok &= load(bgl.BufferData,    "glBufferData");
+    ok &= load(bgl.BufferSubData, "glBufferSubData");
+
+    ok &= load(bgl.CreateShader,       "glCreateShader");
+    ok &= load(bgl.DeleteShader,       "glDeleteShader");
+    ok &= load(bgl.ShaderSource,       "glShaderSource");
+    ok &= load(bgl.CompileShader,      "glCompileShader");
+    ok &= load(bgl.GetShaderiv,        "glGetShaderiv");
+    ok &= load(bgl.GetShaderInfoLog,   "glGetShaderInfoLog");
+    ok &= load(bgl.CreateProgram,      "glCreateProgram");
+    ok &= load(bgl.DeleteProgram,      "glDeleteProgram");
+    ok &= load(bgl.AttachShader,       "glAttachShader");
+    ok &= load(bgl.BindAttribLocation, "glBindAttribLocation");
+    ok &= load(bgl.LinkProgram,        "glLinkProgram");
+    ok &= load(bgl.GetProgramiv,       "glGetProgramiv");
+    ok &= load(bgl.GetProgramInfoLog,  "glGetProgramInfoLog");
+    ok &= load(bgl.UseProgram,         "glUseProgram");
+    ok &= load(bgl.GetUniformLocation, "glGetUniformLocation");
+    ok &= load(bgl.Uniform1i,          "glUniform1i");
+    ok &= load(bgl.Uniform1f,          "glUniform1f");
+    ok &= load(bgl.Uniform2f,          "glUniform2f");
+    ok &= load(bgl.Uniform4f,          "glUniform4f");
+    ok &= load(bgl.UniformMatrix4fv,   "glUniformMatrix4fv");
+
+    ok &= load(bgl.EnableVertexAttribArray,  "glEnableVertexAttribArray");
+    ok &= load(bgl.DisableVertexAttribArray, "glDisableVertexAttribArray");
+    ok &= load(bgl.VertexAttribPointer,      "glVertexAttribPointer");
+    ok &= load(bgl.VertexAttrib4f,           "glVertexAttrib4f");
+    gl_shaders_ok = ok;
+
+    bool inst = ok;
+    inst &= load(bgl.VertexAttribDivisor, "glVertexAttribDivisor", "glVertexAttribDivisorARB");
+    inst &= load(bgl.DrawArraysInstanced, "glDrawArraysInstanced", "glDrawArraysInstancedARB");
+    gl_instancing_ok = inst;
+
+    bool vao = ok;
+    vao &= load(bgl.GenVertexArrays,    "glGenVertexArrays");
+    vao &= load(bgl.DeleteVertexArrays, "glDeleteVertexArrays");
+    vao &= load(bgl.BindVertexArray,    "glBindVertexArray");
+    gl_vao_ok = vao;
+
+    const char* version = (const char*)glGetString(GL_VERSION);
+    int major = 0, minor = 0;
+    if (version) sscanf(version, "%d.%d", &major, &minor);
+
+    // Some drivers hand out pointers for entry points they don't implement,
+    // so timer queries also need the version or the extension.
+    bool timer = major > 3 || (major == 3 && minor >= 3) || glfwExtensionSupported("GL_ARB_timer_query");
+    timer &= load(bgl.GenQueries,          "glGenQueries");
+    timer &= load(bgl.DeleteQueries,       "glDeleteQueries");
+    timer &= load(bgl.QueryCounter,        "glQueryCounter");
+    timer &= load(bgl.GetQueryObjectiv,    "glGetQueryObjectiv");
+    timer &= load(bgl.GetQueryObjectui64v, "glGetQueryObjectui64v");
+    timer &= load(bgl.GetInteger64v,       "glGetInteger64v");
+    gl_timer_ok = timer;
+
+    gl_mipmap_ok = (major >= 3 || glfwExtensionSupported("GL_ARB_framebuffer_object") ||
+                    glfwExtensionSupported("GL_EXT_framebuffer_object")) &&
+                   load(bgl.GenerateMipmap, "glGenerateMipmap", "glGenerateMipmapEXT");
+    gl_swizzle_ok = major > 3 || (major == 3 && minor >= 3) || glfwExtensionSupported("GL_ARB_texture_swizzle");
+
+    // The profile mask only exists from 3.2 on, context flags from 3.0.
+    if (major >= 3) {
+        GLint flags = 0, mask = 0;
+        glGetIntegerv(GL_CONTEXT_FLAGS, &flags);
+        if (major > 3 || minor >= 2) glGetIntegerv(GL_CONTEXT_PROFILE_MASK, &mask);
+        gl_core = (mask & GL_CONTEXT_CORE_PROFILE_BIT) || (flags & GL_CONTEXT_FLAG_FORWARD_COMPATIBLE_BIT);
+    }
+    gl_auto_mipmap = !gl_core && (major > 1 || (major == 1 && minor >= 4));
+
+    return gl_shaders_ok;
+}
+
+bool gl_has_shaders()       { return gl_load_functions(); }
+bool gl_has_instancing()    { return gl_load_functions() && gl_instancing_ok; }
+bool gl_has_vertex_arrays() { return gl_load_functions() && gl_vao_ok; }
+bool gl_has_timer_queries() { gl_load_functions(); return gl_timer_ok; }
+bool gl_has_generate_mipmap() { gl_load_functions(); return gl_mipmap_ok; }
+bool gl_has_texture_swizzle() { gl_load_functions(); return gl_swizzle_ok; }
+bool gl_has_auto_mipmap()   { gl_load_functions(); return gl_auto_mipmap; }
+bool gl_core_context()      { gl_load_functions(); return gl_core; }
+
+static GLuint compile_shader(GLenum type, const char* src) {
+    GLuint shader = bgl.CreateShader(type);
+    bgl.ShaderSource(shader, 1, &src, nullptr);
+    bgl.CompileShader(shader);
+
+    GLint status = 0;
+    bgl.GetShaderiv(shader, GL_COMPILE_STATUS, &status);
+    if (!status) {
+        char log[1024];
+        bgl.GetShaderInfoLog(shader, sizeof(log), nullptr, log);
+        fprintf(stderr, "[bytee] shader compile failed: %s\n", log);
+        bgl.DeleteShader(shader);
+        return 0;
+    }
+    return shader;
+}
+
+GLuint gl_build_program(const char* vs_src, const char* fs_src,
+                        const char* const* attribs, int attrib_count) {
+    if (!gl_has_shaders()) return 0;
+
+    GLuint vs = compile_shader(GL_VERTEX_SHADER, vs_src);
+    GLuint fs = compile_shader(GL_FRAGMENT_SHADER, fs_src);
+    if (!vs || !fs) {
+        if (vs) bgl.DeleteShader(vs);
+        if (fs) bgl.DeleteShader(fs);
+        return 0;
+    }
+
+    GLuint program = bgl.CreateProgram();
+    bgl.AttachShader(program, vs);
+    bgl.AttachShader(program, fs);
+    for (int i = 0; i < attrib_count; i++) bgl.BindAttribLocation(program, i, attribs[i]);
+    bgl.LinkProgram(program);
+    bgl.DeleteShader(vs);
+    bgl.DeleteShader(fs);
+
+    GLint status = 0;
+    bgl.GetProgramiv(program, GL_LINK_STATUS, &status);
+    if (!status) {
+        char log[1024];
+        bgl.GetProgramInfoLog(program, sizeof(log), nullptr, log);
+        fprintf(stderr, "[bytee] shader link failed: %s\n", log);
+        bgl.DeleteProgram(program);
+        return 0;
+    }
+    return program;
+}
@@ -0,0 +1,161 @@
+// Copyright (c) 2026- b0owl / Brennan Marx-Rennie. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to use,
+// copy, modify, and distribute the Software for NON-COMMERCIAL purposes only,
+// subject to the following conditions:
+//
+// 1. The above copyright notice and this permission notice shall be included
+//    in all copies or substantial portions of the Software.
+// 2. The Software may not be used for commercial purposes without prior
+//    written permission from the copyright holder.
+// 3. Commercial use includes, but is not limited to, selling the Software,
+//    using it in a commercial product, or using it to provide commercial services.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+
+#pragma once
+
+// Internal to the engine: GL entry points beyond 1.1 are resolved at runtime
+// through glfwGetProcAddress, so the engine needs no extension loader library.
+// Call gl_load_functions() with a current context before using any of them.
+
+#include <stddef.h>
+#include <stdint.h>
+#ifdef __APPLE__
+  #include <OpenGL/gl.h>
+#else
+  #include <GL/gl.h>
+#endif
+
+#if defined(_WIN32) && !defined(APIENTRY)
+  #define APIENTRY __stdcall
+#elif !defined(APIENTRY)
+  #define APIENTRY
+#endif
+
+#ifndef GL_ARRAY_BUFFER
+  #define GL_ARRAY_BUFFER         0x8892
+  #define GL_STATIC_DRAW          0x88E4
+  #define GL_DYNAMIC_DRAW         0x88E8
+  #define GL_STREAM_DRAW          0x88E0
+#endif
+#ifndef GL_CONTEXT_PROFILE_MASK
+  #define GL_CONTEXT_FLAGS                         0x821E
+  #define GL_CONTEXT_FLAG_FORWARD_COMPATIBLE_BIT   0x0001
+  #define GL_CONTEXT_PROFILE_MASK                  0x9126
+  #define GL_CONTEXT_CORE_PROFILE_BIT              0x0001
+#endif
+#ifndef GL_TIMESTAMP
+  #define GL_QUERY_RESULT                0x8866
+  #define GL_QUERY_RESULT_AVAILABLE      0x8867
+  #define GL_TIMESTAMP                   0x8E28
+#endif
+#ifndef GL_GENERATE_MIPMAP
+  #define GL_GENERATE_MIPMAP      0x8191
+#endif
+#ifndef GL_TEXTURE_MAX_LEVEL
+  #define GL_TEXTURE_MAX_LEVEL    0x813D
+#endif
+#ifndef GL_R8
+  #define GL_R8                   0x8229
+#endif
+#ifndef GL_TEXTURE_SWIZZLE_RGBA
+  #define GL_TEXTURE_SWIZZLE_RGBA 0x8E46
+#endif
+#ifndef GL_UNSIGNED_SHORT_5_6_5
+  #define GL_UNSIGNED_SHORT_4_4_4_4 0x8033
+  #define GL_UNSIGNED_SHORT_5_6_5   0x8363
+#endif
+#ifndef GL_VERTEX_SHADER
+  #define GL_FRAGMENT_SHADER      0x8B30
+  #define GL_VERTEX_SHADER        0x8B31
+  #define GL_COMPILE_STATUS       0x8B81
+  #define GL_LINK_STATUS          0x8B82
+#endif
+
+struct GLFunctions {
+    // Buffers
+    void   (APIENTRY *GenBuffers)(GLsizei, GLuint*);
+    void   (APIENTRY *DeleteBuffers)(GLsizei, const GLuint*);
+    void   (APIENTRY *BindBuffer)(GLenum, GLuint);
+    void   (APIENTRY *BufferData)(GLenum, ptrdiff_t, const void*, GLenum);
+    void   (APIENTRY *BufferSubData)(GLenum, ptrdiff_t, ptrdiff_t, const void*);
+
+    // Shaders
+    GLuint (APIENTRY *CreateShader)(GLenum);
+    void   (APIENTRY *DeleteShader)(GLuint);
+    void   (APIENTRY *ShaderSource)(GLuint, GLsizei, const char* const*, const GLint*);
+    void   (APIENTRY *CompileShader)(GLuint);
+    void   (APIENTRY *GetShaderiv)(GLuint, GLenum, GLint*);
+    void   (APIENTRY *GetShaderInfoLog)(GLuint, GLsizei, GLsizei*, char*);
+    GLuint (APIENTRY *CreateProgram)();
+    void   (APIENTRY *DeleteProgram)(GLuint);
+    void   (APIENTRY *AttachShader)(GLuint, GLuint);
+    void   (APIENTRY *BindAttribLocation)(GLuint, GLuint, const char*);
+    void   (APIENTRY *LinkProgram)(GLuint);
+    void   (APIENTRY *GetProgramiv)(GLuint, GLenum, GLint*);
+    void   (APIENTRY *GetProgramInfoLog)(GLuint, GLsizei, GLsizei*, char*);
+    void   (APIENTRY *UseProgram)(GLuint);
+    GLint  (APIENTRY *GetUniformLocation)(GLuint, const char*);
+    void   (APIENTRY *Uniform1i)(GLint, GLint);
+    void   (APIENTRY *Uniform1f)(GLint, GLfloat);
+    void   (APIENTRY *Uniform2f)(GLint, GLfloat, GLfloat);
+    void   (APIENTRY *Uniform4f)(GLint, GLfloat, GLfloat, GLfloat, GLfloat);
+    void   (APIENTRY *UniformMatrix4fv)(GLint, GLsizei, GLboolean, const GLfloat*);
+
+    // Vertex attributes
+    void   (APIENTRY *EnableVertexAttribArray)(GLuint);
+    void   (APIENTRY *DisableVertexAttribArray)(GLuint);
+    void   (APIENTRY *VertexAttribPointer)(GLuint, GLint, GLenum, GLboolean, GLsizei, const void*);
+    void   (APIENTRY *VertexAttrib4f)(GLuint, GLfloat, GLfloat, GLfloat, GLfloat);
+
+    // Vertex array objects (GL 3.0 / ARB_vertex_array_object)
+    void   (APIENTRY *GenVertexArrays)(GLsizei, GLuint*);
+    void   (APIENTRY *DeleteVertexArrays)(GLsizei, const GLuint*);
+    void   (APIENTRY *BindVertexArray)(GLuint);
+
+    // Instancing (GL 3.3 / ARB_instanced_arrays + ARB_draw_instanced)
+    void   (APIENTRY *VertexAttribDivisor)(GLuint, GLuint);
+    void   (APIENTRY *DrawArraysInstanced)(GLenum, GLint, GLsizei, GLsizei);
+
+    // Timer queries (GL 3.3 / ARB_timer_query)
+    void   (APIENTRY *GenQueries)(GLsizei, GLuint*);
+    void   (APIENTRY *DeleteQueries)(GLsizei, const GLuint*);
+    void   (APIENTRY *QueryCounter)(GLuint, GLenum);
+    void   (APIENTRY *GetQueryObjectiv)(GLuint, GLenum, GLint*);
+    void   (APIENTRY *GetQueryObjectui64v)(GLuint, GLenum, uint64_t*);
+    void   (APIENTRY *GetInteger64v)(GLenum, int64_t*);
+
+    // Textures (GL 3.0 / ARB_framebuffer_object, or EXT_framebuffer_object)
+    void   (APIENTRY *GenerateMipmap)(GLenum);
+};
+
+extern GLFunctions bgl;
+
+bool gl_load_functions();
+bool gl_has_shaders();
+bool gl_has_instancing();
+bool gl_has_vertex_arrays();
+bool gl_has_timer_queries();
+bool gl_has_generate_mipmap();
+
+// GL_R8 textures with GL_TEXTURE_SWIZZLE_RGBA (GL 3.3 / ARB_texture_swizzle).
+bool gl_has_texture_swizzle();
+
+// GL_GENERATE_MIPMAP texture parameter, the GL 1.4 way to get mipmaps on
+// contexts without glGenerateMipmap. Not available on core profiles.
+bool gl_has_auto_mipmap();
+
+// True for core-profile and forward-compatible contexts, where the
+// fixed-function pipeline (matrices, glBegin, client arrays, GL_TEXTURE_2D
+// enables) doesn't exist.
+bool gl_core_context();
+
+// Compiles and links a program from vertex + fragment source. Attribute names
+// are bound to locations 0..n-1 in order before linking. Returns 0 on failure
+// and prints the info log to stderr.
+GLuint gl_build_program(const char* vs_src, const char* fs_src,
+                        const char* const* attribs, int attrib_count);
@@ -0,0 +1,214 @@
+// Copyright (c) 2026- b0owl / Brennan Marx-Rennie. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to use,
+// copy, modify, and distribute the Software for NON-COMMERCIAL purposes only,
+// subject to the following conditions:
+//
+// 1. The above copyright notice and this permission notice shall be included
+//    in all copies or substantial portions of the Software.
+// 2. The Software may not be used for commercial purposes without prior
+//    written permission from the copyright holder.
+// 3. Commercial use includes, but is not limited to, selling the Software,
+//    using it in a commercial product, or using it to provide commercial services.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+
+#ifdef __APPLE__
+  #include <OpenGL/gl.h>
+#else
+  #include <GL/gl.h>
+#endif
+
+#include "../include/gl_state.h"
+#include "gl_functions.h"
+#include "core_backend.h"
+
+// -1 means unknown: the next call always reaches GL. Fresh contexts start
+// unknown too, so nothing is assumed about the state a window was created with.
+enum { CAP_BLEND, CAP_TEXTURE_2D, CAP_ALPHA_TEST, CAP_COUNT };
+enum { ARRAY_VERTEX, ARRAY_TEXCOORD, ARRAY_COLOR, ARRAY_COUNT };
+
+struct ShadowState {
+    int caps[CAP_COUNT];
+    int arrays[ARRAY_COUNT];
+    long long blend_src, blend_dst;
+    long long texture;
+    long long program;
+    long long vertex_array;
+};
+
+static ShadowState unknown_state() {
+    ShadowState state;
+    for (int& cap : state.caps) cap = -1;
+    for (int& array : state.arrays) array = -1;
+    state.blend_src = state.blend_dst = -1;
+    state.texture = -1;
+    state.program = -1;
+    state.vertex_array = -1;
+    return state;
+}
+
+static ShadowState shadow = unknown_state();
+static GLStateStats frame_stats = {};
+static GLStateStats last_frame_stats = {};
+
+static bool fixed_function_only(unsigned int cap) {
+    return cap == GL_TEXTURE_2D || cap == GL_ALPHA_TEST;
+}
+
+static int cap_index(unsigned int cap) {
+    switch (cap) {
+        case GL_BLEND:      return CAP_BLEND;
+        case GL_TEXTURE_2D: return CAP_TEXTURE_2D;
+        case GL_ALPHA_TEST: return CAP_ALPHA_TEST;
+        default:            return -1;
+    }
+}
+
+static int array_index(unsigned int array) {
+    switch (array) {
+        case GL_VERTEX_ARRAY:        return ARRAY_VERTEX;
+        case GL_TEXTURE_COORD_ARRAY: return ARRAY_TEXCOORD;
+        case GL_COLOR_ARRAY:         return ARRAY_COLOR;
+        default:                     return -1;
+    }
+}
+
+/* @brief, returns true if slot already holds value, otherwise stores it and counts a change */
+static bool unchanged(int& slot, int value) {
+    if (slot == value) { frame_stats.skipped++; return true; }
+    slot = value;
+    frame_stats.changes++;
+    return false;
+}
+
+void gls_enable(unsigned int cap) {
+    if (fixed_function_only(cap) && gl_core_context()) return;
+    int i = cap_index(cap);
+    if (i >= 0 && unchanged(shadow.caps[i], 1)) return;
+    if (i < 0) frame_stats.changes++;
+    glEnable(cap);
+}
+
+void gls_disable(unsigned int cap) {
+    if (fixed_function_only(cap) && gl_core_context()) return;
+    int i = cap_index(cap);
+    if (i >= 0 && unchanged(shadow.caps[i], 0)) return;
+    if (i < 0) frame_stats.changes++;
+    glDisable(cap);
+}
+
+void gls_blend_func(unsigned int src, unsigned int dst) {
+    if (shadow.blend_src == src && shadow.blend_dst == dst) { frame_stats.skipped++; return; }
+    shadow.blend_src = src;
+    shadow.blend_dst = dst;
+    frame_stats.changes++;
+    glBlendFunc(src, dst);
+}
+
+/* @brief, binds tex to GL_TEXTURE_2D on the active texture unit */
+void gls_bind_texture(unsigned int tex) {
+    if (shadow.texture == tex) { frame_stats.skipped++; return; }
+    shadow.texture = tex;
+    frame_stats.changes++;
+    frame_stats.texture_binds++;
+    glBindTexture(GL_TEXTURE_2D, tex);
+}
+
+/*
+@brief, creates a texture name. The null renderer has no context to ask, so
+        it hands out names of its own.
+*/
+unsigned int gls_gen_texture() {
+    static unsigned int null_textures = 0;
+    if (null_backend_active()) return ++null_textures;
+    unsigned int tex = 0;
+    glGenTextures(1, &tex);
+    return tex;
+}
+
+/*
+@brief, deletes a texture. GL unbinds a deleted texture and may hand its name
+        out again, so the cached binding has to be forgotten along with it.
+*/
+void gls_delete_texture(unsigned int tex) {
+    if (shadow.texture == tex) shadow.texture = 0;
+    if (!null_backend_active()) glDeleteTextures(1, &tex);
+}
+
+void gls_use_program(unsigned int program) {
+    if (shadow.program == program) { frame_stats.skipped++; return; }
+    // Nothing to bind or unbind without shader support.
+    if (!gl_has_shaders()) { shadow.program = 0; return; }
+    shadow.program = program;
+    frame_stats.changes++;
+    frame_stats.program_binds++;
+    bgl.UseProgram(program);
+}
+
+/* @brief, binds a vertex array object; a no-op where VAOs aren't available */
+void gls_bind_vertex_array(unsigned int vao) {
+    if (shadow.vertex_array == vao) { frame_stats.skipped++; return; }
+    if (!gl_has_vertex_arrays()) { shadow.vertex_array = 0; return; }
+    shadow.vertex_array = vao;
+    frame_stats.changes++;
+    bgl.BindVertexArray(vao);
+}
+
+void gls_enable_client(unsigned int array) {
+    if (gl_core_context()) return;
+    int i = array_index(array);
+    if (i >= 0 && unchanged(shadow.arrays[i], 1)) return;
+    if (i < 0) frame_stats.changes++;
+    glEnableClientState(array);
+}
+
+void gls_disable_client(unsigned int array) {
+    if (gl_core_context()) return;
+    int i = array_index(array);
+    if (i >= 0 && unchanged(shadow.arrays[i], 0)) return;
+    if (i < 0) frame_stats.changes++;
+    glDisableClientState(array);
+}
+
+/* @brief, records a draw call of `vertices` vertices in the frame counters */
+void gls_count_draw(int vertices) {
+    frame_stats.draw_calls++;
+    frame_stats.vertices += vertices;
+}
+
+/* @brief, forgets the cached state; every tracked call reaches GL once more */
+void gls_invalidate() {
+    shadow = unknown_state();
+}
+
+/*
+@brief, puts the tracked state back to GL's defaults: nothing enabled, no
+        texture or program bound. Only calls that change something are made.
+*/
+void gls_reset_defaults() {
+    if (null_backend_active()) return;
+    gls_disable(GL_BLEND);
+    gls_disable(GL_TEXTURE_2D);
+    gls_disable(GL_ALPHA_TEST);
+    gls_disable_client(GL_VERTEX_ARRAY);
+    gls_disable_client(GL_TEXTURE_COORD_ARRAY);
+    gls_disable_client(GL_COLOR_ARRAY);
+    gls_bind_texture(0);
+    gls_use_program(0);
+    gls_bind_vertex_array(0);
+}
+
+/* @brief, closes the frame's counters; gls_stats reports them until the next call */
+void gls_end_frame() {
+    last_frame_stats = frame_stats;
+    frame_stats = GLStateStats{};
+}
+
+/* @brief, returns the counters of the last completed frame */
+GLStateStats gls_stats() {
+    return last_frame_stats;
+}
@@ -0,0 +1,265 @@
+// Copyright (c) 2026- b0owl / Brennan Marx-Rennie. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to use,
+// copy, modify, and distribute the Software for NON-COMMERCIAL purposes only,
+// subject to the following conditions:
+//
+// 1. The above copyright notice and this permission notice shall be included
+//    in all copies or substantial portions of the Software.
+// 2. The Software may not be used for commercial purposes without prior
+//    written permission from the copyright holder.
+// 3. Commercial use includes, but is not limited to, selling the Software,
+//    using it in a commercial product, or using it to provide commercial services.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+
+#include <stdint.h>
+#include <string.h>
+#include <vector>
+#include <unordered_map>
+#include "../include/allocator.h"
+#include "../include/gl_state.h"
+#include "gl_functions.h"
+#include "core_backend.h"
+#include "instanced_draw.h"
+
+// Per-instance attributes, mirrored from DrawData.
+struct InstanceData {
+    float x, y;
+    float r, g, b;
+};
+
+// Instances are re-uploaded in chunks; a chunk is only sent to the GPU when
+// one of its objects changed since the previous frame.
+static const int INSTANCE_CHUNK = 64;
+
+enum { ATTR_POS = 0, ATTR_OFFSET = 1, ATTR_COLOR = 2 };
+
+struct ShapeGroup {
+    float vertices[12];
+    int vertex_count;
+    GLuint shape_vbo;
+    GLuint instance_vbo;
+    int gpu_capacity;                     // instances instance_vbo can hold
+    int used;                             // instances written this frame
+    std::vector<InstanceData> instances;  // shadow copy of the GPU buffer
+    std::vector<unsigned char> dirty;     // one flag per INSTANCE_CHUNK
+};
+
+struct InstancedGroups {
+    std::vector<ShapeGroup> groups;
+    std::unordered_multimap<uint64_t, int> lookup;  // shape hash -> group index
+};
+
+static const char* INSTANCED_VS =
+    "#version 120\n"
+    "attribute vec2 a_pos;\n"
+    "attribute vec2 a_offset;\n"
+    "attribute vec3 a_color;\n"
+    "varying vec3 v_color;\n"
+    "void main() {\n"
+    "    v_color = a_color;\n"
+    "    gl_Position = gl_ModelViewProjectionMatrix * vec4(a_pos + a_offset, 0.0, 1.0);\n"
+    "}\n";
+
+static const char* INSTANCED_FS =
+    "#version 120\n"
+    "varying vec3 v_color;\n"
+    "void main() {\n"
+    "    gl_FragColor = vec4(v_color, 1.0);\n"
+    "}\n";
+
+// Core-profile variants; the projection comes from a uniform.
+static const char* INSTANCED_VS_330 =
+    "#version 330 core\n"
+    "in vec2 a_pos;\n"
+    "in vec2 a_offset;\n"
+    "in vec3 a_color;\n"
+    "uniform mat4 u_proj;\n"
+    "out vec3 v_color;\n"
+    "void main() {\n"
+    "    v_color = a_color;\n"
+    "    gl_Position = u_proj * vec4(a_pos + a_offset, 0.0, 1.0);\n"
+    "}\n";
+
+static const char* INSTANCED_FS_330 =
+    "#version 330 core\n"
+    "in vec3 v_color;\n"
+    "out vec4 frag_color;\n"
+    "void main() {\n"
+    "    frag_color = vec4(v_color, 1.0);\n"
+    "}\n";
+
+static GLuint instanced_program = 0;
+static bool   instanced_failed  = false;
+static bool   instanced_core    = false;
+static GLint  instanced_u_proj  = -1;
+static unsigned int instanced_proj_version = 0;
+static GLuint instanced_vao = 0;  // core profile only
+
+static uint64_t shape_hash(const DrawData* data) {
+    uint64_t h = 1469598103934665603ull;  // FNV-1a
+    const unsigned char* bytes = (const unsigned char*)data->vertices;
+    size_t len = (size_t)data->vertex_count * 2 * sizeof(float);
+    for (size_t i = 0; i < len; i++) { h ^= bytes[i]; h *= 1099511628211ull; }
+    return h ^ (uint64_t)data->vertex_count;
+}
+
+static bool same_shape(const ShapeGroup& g, const DrawData* data) {
+    return g.vertex_count == data->vertex_count &&
+           memcmp(g.vertices, data->vertices, data->vertex_count * 2 * sizeof(float)) == 0;
+}
+
+static int find_group(InstancedGroups* groups, const DrawData* data) {
+    uint64_t h = shape_hash(data);
+    auto range = groups->lookup.equal_range(h);
+    for (auto it = range.first; it != range.second; ++it) {
+        if (same_shape(groups->groups[it->second], data)) return it->second;
+    }
+
+    ShapeGroup g;
+    memcpy(g.vertices, data->vertices, sizeof(g.vertices));
+    g.vertex_count = data->vertex_count;
+    g.instance_vbo = 0;
+    g.gpu_capacity = 0;
+    g.used = 0;
+    bgl.GenBuffers(1, &g.shape_vbo);
+    bgl.BindBuffer(GL_ARRAY_BUFFER, g.shape_vbo);
+    bgl.BufferData(GL_ARRAY_BUFFER, g.vertex_count * 2 * sizeof(float), g.vertices, GL_STATIC_DRAW);
+
+    int index = (int)groups->groups.size();
+    groups->groups.push_back(std::move(g));
+    groups->lookup.emplace(h, index);
+    return index;
+}
+
+static void write_instance(ShapeGroup& g, const DrawData* data) {
+    InstanceData d = { data->x, data->y, data->r, data->g, data->b };
+    int i = g.used++;
+    if (i == (int)g.instances.size()) {
+        g.instances.push_back(d);
+        g.dirty.resize((g.instances.size() + INSTANCE_CHUNK - 1) / INSTANCE_CHUNK, 1);
+        g.dirty[i / INSTANCE_CHUNK] = 1;
+    } else if (memcmp(&g.instances[i], &d, sizeof(d)) != 0) {
+        g.instances[i] = d;
+        g.dirty[i / INSTANCE_CHUNK] = 1;
+    }
+}
+
+// Sends changed instances to the GPU. Consecutive dirty chunks are merged into
+// one glBufferSubData; a full reallocation only happens when the group grows.
+static void upload_instances(ShapeGroup& g) {
+    if (g.instance_vbo == 0) bgl.GenBuffers(1, &g.instance_vbo);
+    bgl.BindBuffer(GL_ARRAY_BUFFER, g.instance_vbo);
+
+    if (g.used > g.gpu_capacity) {
+        int capacity = g.gpu_capacity ? g.gpu_capacity : INSTANCE_CHUNK;
+        while (capacity < g.used) capacity *= 2;
+        g.instances.reserve(capacity);
+        bgl.BufferData(GL_ARRAY_BUFFER, capacity * sizeof(InstanceData), nullptr, GL_DYNAMIC_DRAW);
+        bgl.BufferSubData(GL_ARRAY_BUFFER, 0, g.used * sizeof(InstanceData), g.instances.data());
+        g.gpu_capacity = capacity;
+        for (unsigned char& flag : g.dirty) flag = 0;
+        return;
+    }
+
+    int chunks = (g.used + INSTANCE_CHUNK - 1) / INSTANCE_CHUNK;
+    for (int c = 0; c < chunks; c++) {
+        if (!g.dirty[c]) continue;
+        int first = c;
+        while (c + 1 < chunks && g.dirty[c + 1]) c++;
+
+        int begin = first * INSTANCE_CHUNK;
+        int end = (c + 1) * INSTANCE_CHUNK;
+        if (end > g.used) end = g.used;
+        bgl.BufferSubData(GL_ARRAY_BUFFER, begin * sizeof(InstanceData),
+                          (end - begin) * sizeof(InstanceData), &g.instances[begin]);
+        for (int k = first; k <= c; k++) g.dirty[k] = 0;
+    }
+}
+
+InstancedGroups* instanced_create() {
+    return new InstancedGroups();
+}
+
+void instanced_destroy(InstancedGroups* groups) {
+    if (!groups) return;
+    for (ShapeGroup& g : groups->groups) {
+        bgl.DeleteBuffers(1, &g.shape_vbo);
+        if (g.instance_vbo) bgl.DeleteBuffers(1, &g.instance_vbo);
+    }
+    delete groups;
+}
+
+bool instanced_draw(InstancedGroups* groups, void** ptr, int count) {
+    if (instanced_failed || !gl_has_instancing()) return false;
+    if (!instanced_program) {
+        const char* attribs[] = { "a_pos", "a_offset", "a_color" };
+        instanced_core = core_backend_active();
+        instanced_program = instanced_core
+            ? gl_build_program(INSTANCED_VS_330, INSTANCED_FS_330, attribs, 3)
+            : gl_build_program(INSTANCED_VS, INSTANCED_FS, attribs, 3);
+        if (!instanced_program) { instanced_failed = true; return false; }
+        if (instanced_core) {
+            instanced_u_proj = bgl.GetUniformLocation(instanced_program, "u_proj");
+            bgl.GenVertexArrays(1, &instanced_vao);
+        }
+    }
+
+    for (ShapeGroup& g : groups->groups) g.used = 0;
+
+    // Runs of objects usually share a shape, so check the previous group
+    // before hashing.
+    int last = -1;
+    for (int i = 0; i < count; i++) {
+        if (ptr[i] == nullptr) continue;
+        const DrawData* data = (const DrawData*)ptr[i];
+        if (data->vertex_count < 3 || data->vertex_count > 6) continue;
+        if (last < 0 || !same_shape(groups->groups[last], data)) last = find_group(groups, data);
+        write_instance(groups->groups[last], data);
+    }
+
+    // Attribute 0 aliases the fixed-function vertex array on some drivers, so
+    // the client arrays left on by the sprite batch must be off here.
+    gls_disable_client(GL_VERTEX_ARRAY);
+    gls_disable_client(GL_TEXTURE_COORD_ARRAY);
+    gls_disable_client(GL_COLOR_ARRAY);
+    gls_use_program(instanced_program);
+    if (instanced_core) {
+        gls_bind_vertex_array(instanced_vao);
+        core_apply_projection(instanced_u_proj, instanced_proj_version);
+    }
+    bgl.EnableVertexAttribArray(ATTR_POS);
+    bgl.EnableVertexAttribArray(ATTR_OFFSET);
+    bgl.EnableVertexAttribArray(ATTR_COLOR);
+    bgl.VertexAttribDivisor(ATTR_OFFSET, 1);
+    bgl.VertexAttribDivisor(ATTR_COLOR, 1);
+
+    for (ShapeGroup& g : groups->groups) {
+        if (g.used == 0) continue;
+        upload_instances(g);
+
+        bgl.BindBuffer(GL_ARRAY_BUFFER, g.shape_vbo);
+        bgl.VertexAttribPointer(ATTR_POS, 2, GL_FLOAT, GL_FALSE, 0, (const void*)0);
+        bgl.BindBuffer(GL_ARRAY_BUFFER, g.instance_vbo);
+        bgl.VertexAttribPointer(ATTR_OFFSET, 2, GL_FLOAT, GL_FALSE, sizeof(InstanceData),
+                                (const void*)offsetof(InstanceData, x));
+        bgl.VertexAttribPointer(ATTR_COLOR, 3, GL_FLOAT, GL_FALSE, sizeof(InstanceData),
+                                (const void*)offsetof(InstanceData, r));
+        bgl.DrawArraysInstanced(GL_TRIANGLE_FAN, 0, g.vertex_count, g.used);
+        gls_count_draw(g.vertex_count * g.used);
+    }
+
+    // Divisors are global attribute state without a VAO; reset them so other
+    // draw paths using these locations aren't affected.
+    bgl.VertexAttribDivisor(ATTR_OFFSET, 0);
+    bgl.VertexAttribDivisor(ATTR_COLOR, 0);
+    bgl.DisableVertexAttribArray(ATTR_COLOR);
+    bgl.DisableVertexAttribArray(ATTR_OFFSET);
+    bgl.DisableVertexAttribArray(ATTR_POS);
+    bgl.BindBuffer(GL_ARRAY_BUFFER, 0);
+    return true;
+}
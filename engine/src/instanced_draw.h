@@ -0,0 +1,33 @@
+// Copyright (c) 2026- b0owl / Brennan Marx-Rennie. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to use,
+// copy, modify, and distribute the Software for NON-COMMERCIAL purposes only,
+// subject to the following conditions:
+//
+// 1. The above copyright notice and this permission notice shall be included
+//    in all copies or substantial portions of the Software.
+// 2. The Software may not be used for commercial purposes without prior
+//    written permission from the copyright holder.
+// 3. Commercial use includes, but is not limited to, selling the Software,
+//    using it in a commercial product, or using it to provide commercial services.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+
+#pragma once
+
+// Internal to the engine: retained, instanced renderer behind
+// Allocator::draw_struct. Objects are grouped by shape; each shape's vertices
+// are uploaded once and every object using it is drawn by a single instanced
+// call with per-instance position and color.
+
+struct InstancedGroups;
+
+InstancedGroups* instanced_create();
+void instanced_destroy(InstancedGroups* groups);
+
+// Returns false if instancing isn't usable, in which case nothing was drawn
+// and the caller should fall back to immediate mode.
+bool instanced_draw(InstancedGroups* groups, void** ptr, int count);
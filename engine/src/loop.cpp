@@ -0,0 +1,146 @@
+// Copyright (c) 2026- b0owl / Brennan Marx-Rennie. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to use,
+// copy, modify, and distribute the Software for NON-COMMERCIAL purposes only,
+// subject to the following conditions:
+//
+// 1. The above copyright notice and this permission notice shall be included
+//    in all copies or substantial portions of the Software.
+// 2. The Software may not be used for commercial purposes without prior
+//    written permission from the copyright holder.
+// 3. Commercial use includes, but is not limited to, selling the Software,
+//    using it in a commercial product, or using it to provide commercial services.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+
+#include "../include/loop.h"
+#include "../include/window.h"
+#include "../include/profiler.h"
+#include <chrono>
+#include <thread>
+
+double get_time() {
+    return glfwGetTime();
+}
+
+/*
+@brief, creates an accumulator for a fixed simulation step
+
+@param step,         simulation step in seconds, e.g. 1.0 / 60.0
+@param max_frame_dt, frame times above this are clamped (after a stall the
+                     simulation slows down instead of running hundreds of steps)
+*/
+FixedTimestep fixed_timestep(double step, double max_frame_dt) {
+    return FixedTimestep{ step, max_frame_dt, 0.0, 0.0, 0 };
+}
+
+/*
+@brief, adds a frame's time to the accumulator and updates alpha
+
+@param ts,       the accumulator
+@param frame_dt, wall time of the last frame in seconds
+@returns how many fixed steps to simulate this frame
+*/
+int fixed_timestep_advance(FixedTimestep* ts, double frame_dt) {
+    if (ts->step <= 0.0) return 0;
+    if (frame_dt < 0.0) frame_dt = 0.0;
+    if (frame_dt > ts->max_frame_dt) frame_dt = ts->max_frame_dt;
+
+    ts->accumulator += frame_dt;
+    int steps = (int)(ts->accumulator / ts->step);
+    ts->accumulator -= steps * ts->step;
+    ts->alpha = ts->accumulator / ts->step;
+    ts->steps += steps;
+    return steps;
+}
+
+/* @brief, creates a limiter for target_fps frames per second; 0 disables it */
+FrameLimiter frame_limiter(double target_fps) {
+    return FrameLimiter{ target_fps > 0.0 ? 1.0 / target_fps : 0.0, 0.0, 0.002 };
+}
+
+/*
+@brief, waits until the current frame's deadline, then moves it one period on.
+        Call once per frame, after glCleanup. Deadlines advance by a fixed
+        period, so frame pacing doesn't drift; a frame more than one period
+        late resets the schedule instead of rushing to catch up.
+*/
+void frame_limiter_wait(FrameLimiter* limiter) {
+    if (limiter->period <= 0.0) return;
+
+    double now = glfwGetTime();
+    if (limiter->next <= 0.0 || now >= limiter->next + limiter->period) {
+        limiter->next = now + limiter->period;
+        return;
+    }
+
+    double sleep_for = limiter->next - now - limiter->spin;
+    if (sleep_for > 0.0) {
+        std::this_thread::sleep_for(std::chrono::duration<double>(sleep_for));
+        // Grow the spin margin to the worst oversleep seen, then let it decay
+        // slowly, so coarse OS timers don't make us miss deadlines.
+        double late = glfwGetTime() - (now + sleep_for);
+        if (late > limiter->spin) limiter->spin = late * 1.25;
+        else limiter->spin = limiter->spin * 0.99 + late * 0.01;
+        if (limiter->spin > limiter->period) limiter->spin = limiter->period;
+    }
+    while (glfwGetTime() < limiter->next) std::this_thread::yield();
+
+    limiter->next += limiter->period;
+}
+
+LoopConfig default_loop_config() {
+    return LoopConfig{ 1.0 / 60.0, 0.25, 0.0 };
+}
+
+/*
+@brief, runs the main loop until the window should close. Every frame: run
+        update for each fixed step that is due, update the viewport, call
+        render with the interpolation factor, glCleanup, then the frame
+        limiter.
+
+@param window, GLFW window
+@param config, timestep and frame limiter settings
+@param update, called with config.fixed_dt for every simulation step
+@param render, called once per frame; interpolate positions with frame.alpha
+*/
+void run_loop(GLFWwindow* window, const LoopConfig& config,
+              const std::function<void(double dt)>& update,
+              const std::function<void(const LoopFrame& frame)>& render) {
+    FixedTimestep ts = fixed_timestep(config.fixed_dt, config.max_frame_dt);
+    FrameLimiter limiter = frame_limiter(config.target_fps);
+    LoopFrame frame = {};
+    glfwGetFramebufferSize(window, &frame.fb_w, &frame.fb_h);
+    frame.aspect = frame.fb_h > 0 ? (float)frame.fb_w / (float)frame.fb_h : 1.0f;
+
+    double start = glfwGetTime();
+    double last = start;
+    while (!glfwWindowShouldClose(window)) {
+        double now = glfwGetTime();
+        double frame_dt = now - last;
+        last = now;
+
+        int steps = fixed_timestep_advance(&ts, frame_dt);
+        if (update) {
+            PROFILE_SCOPE("fixed_update");
+            for (int i = 0; i < steps; i++) update(ts.step);
+        }
+
+        update_viewport(window, &frame.fb_w, &frame.fb_h, &frame.aspect);
+        frame.time = now - start;
+        frame.frame_dt = frame_dt < config.max_frame_dt ? frame_dt : config.max_frame_dt;
+        frame.alpha = ts.alpha;
+        if (render) {
+            PROFILE_SCOPE("render");
+            render(frame);
+        }
+        frame.frame++;
+
+        glCleanup(window);
+        PROFILE_SCOPE("frame_limiter");
+        frame_limiter_wait(&limiter);
+    }
+}
@@ -0,0 +1,227 @@
+// Copyright (c) 2026- b0owl / Brennan Marx-Rennie. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to use,
+// copy, modify, and distribute the Software for NON-COMMERCIAL purposes only,
+// subject to the following conditions:
+//
+// 1. The above copyright notice and this permission notice shall be included
+//    in all copies or substantial portions of the Software.
+// 2. The Software may not be used for commercial purposes without prior
+//    written permission from the copyright holder.
+// 3. Commercial use includes, but is not limited to, selling the Software,
+//    using it in a commercial product, or using it to provide commercial services.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+
+#ifdef _WIN32
+  #define WIN32_LEAN_AND_MEAN
+  #define NOMINMAX
+  #include <windows.h>
+#else
+  #include <fcntl.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <unistd.h>
+#endif
+
+#include <stdio.h>
+#include <string.h>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "../include/pack.h"
+#include "../include/assets.h"
+#include "pack_internal.h"
+
+struct MountedPack {
+    std::string path;
+    std::string prefix;
+    const unsigned char* base;
+    size_t size;
+#ifdef _WIN32
+    HANDLE file;
+    HANDLE mapping;
+#endif
+};
+
+// Searched back to front, so later mounts win.
+static std::vector<std::unique_ptr<MountedPack>> mounts;
+static std::mutex pack_mutex;
+
+/* @brief, maps the whole file read-only; false if it can't be opened or is empty */
+static bool map_file(const char* path, MountedPack& pack) {
+#ifdef _WIN32
+    pack.file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                            FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (pack.file == INVALID_HANDLE_VALUE) return false;
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(pack.file, &size) || size.QuadPart == 0) { CloseHandle(pack.file); return false; }
+    pack.mapping = CreateFileMappingA(pack.file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!pack.mapping) { CloseHandle(pack.file); return false; }
+    pack.base = (const unsigned char*)MapViewOfFile(pack.mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!pack.base) { CloseHandle(pack.mapping); CloseHandle(pack.file); return false; }
+    pack.size = (size_t)size.QuadPart;
+    return true;
+#else
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return false;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size == 0) { close(fd); return false; }
+    void* base = mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);  // the mapping keeps the file alive
+    if (base == MAP_FAILED) return false;
+    pack.base = (const unsigned char*)base;
+    pack.size = (size_t)st.st_size;
+    return true;
+#endif
+}
+
+static void unmap_file(MountedPack& pack) {
+#ifdef _WIN32
+    UnmapViewOfFile(pack.base);
+    CloseHandle(pack.mapping);
+    CloseHandle(pack.file);
+#else
+    munmap((void*)pack.base, pack.size);
+#endif
+    pack.base = nullptr;
+}
+
+static const PackHeader* header_of(const MountedPack& pack) {
+    return (const PackHeader*)pack.base;
+}
+
+static const PackEntry* slots_of(const MountedPack& pack) {
+    return (const PackEntry*)(pack.base + header_of(pack)->index_offset);
+}
+
+/* @brief, checks every offset in the archive against the mapping, so lookups never read past it */
+static bool validate(const MountedPack& pack) {
+    if (pack.size < sizeof(PackHeader)) return false;
+    const PackHeader* header = header_of(pack);
+    if (memcmp(header->magic, PACK_MAGIC, 4) != 0 || header->version != PACK_VERSION) return false;
+    if (header->file_size != pack.size) return false;
+    if (header->slot_count == 0 || (header->slot_count & (header->slot_count - 1))) return false;
+    if (header->index_offset % 8 || header->index_offset > pack.size ||
+        (pack.size - header->index_offset) / sizeof(PackEntry) < header->slot_count) return false;
+    if (header->names_offset > pack.size) return false;
+
+    const PackEntry* slots = slots_of(pack);
+    for (uint32_t i = 0; i < header->slot_count; i++) {
+        const PackEntry& entry = slots[i];
+        if (entry.type == PACK_EMPTY) continue;
+        if ((uint64_t)entry.name_offset + entry.name_length > pack.size - header->names_offset) return false;
+        if (entry.data_offset % PACK_ALIGN || entry.data_offset > pack.size ||
+            entry.data_size > pack.size - entry.data_offset) return false;
+        if (entry.width <= 0 || entry.height <= 0) return false;
+        uint64_t texels = (uint64_t)entry.width * entry.height;
+        if (entry.type == PACK_IMAGE &&
+            (entry.channels < 1 || entry.channels > 4 || entry.data_size < texels * entry.channels)) return false;
+        if (entry.type == PACK_FONT && entry.data_size < sizeof(PackFont) + texels) return false;
+    }
+    return true;
+}
+
+// Names are stored with forward slashes and without a leading "./".
+static std::string normalize(const char* path) {
+    std::string name = path;
+    for (char& c : name) if (c == '\\') c = '/';
+    while (name.compare(0, 2, "./") == 0) name.erase(0, 2);
+    return name;
+}
+
+static const PackEntry* find_in(const MountedPack& pack, const char* name, size_t length) {
+    const PackHeader* header = header_of(pack);
+    const PackEntry* slots = slots_of(pack);
+    const char* names = (const char*)pack.base + header->names_offset;
+    uint64_t hash = pack_hash(name, length);
+    uint32_t mask = header->slot_count - 1;
+
+    for (uint32_t probe = 0, i = (uint32_t)hash & mask; probe < header->slot_count; probe++, i = (i + 1) & mask) {
+        const PackEntry& entry = slots[i];
+        if (entry.type == PACK_EMPTY) return nullptr;
+        if (entry.hash == hash && entry.name_length == length &&
+            memcmp(names + entry.name_offset, name, length) == 0) return &entry;
+    }
+    return nullptr;
+}
+
+const PackEntry* pack_find(const std::string& path, PackEntryType type, const unsigned char** out_data) {
+    std::lock_guard<std::mutex> lock(pack_mutex);
+    if (mounts.empty()) return nullptr;
+
+    std::string name = normalize(path.c_str());
+    for (auto it = mounts.rbegin(); it != mounts.rend(); ++it) {
+        const MountedPack& pack = **it;
+        if (name.compare(0, pack.prefix.size(), pack.prefix) != 0) continue;
+        const PackEntry* entry = find_in(pack, name.c_str() + pack.prefix.size(), name.size() - pack.prefix.size());
+        if (entry && entry->type == type) {
+            if (out_data) *out_data = pack.base + entry->data_offset;
+            return entry;
+        }
+    }
+    return nullptr;
+}
+
+/*
+@brief, maps a packed archive built by tools/pack_assets and makes its
+        entries visible to the loaders. Textures and fonts that are already
+        cached stay as they are.
+
+@param pack_path, the .pak file
+@param prefix,    directory the archive replaces, e.g. "assets/"; "" matches
+                  paths exactly as they were packed
+@returns false if the file can't be mapped or isn't a valid archive
+*/
+bool mount_pack(const char* pack_path, const char* prefix) {
+    std::unique_ptr<MountedPack> pack(new MountedPack());
+    pack->path = pack_path;
+    pack->prefix = normalize(prefix ? prefix : "");
+    if (!pack->prefix.empty() && pack->prefix.back() != '/') pack->prefix += '/';
+
+    if (!map_file(pack_path, *pack)) {
+        fprintf(stderr, "[bytee] can't open pack %s\n", pack_path);
+        return false;
+    }
+    if (!validate(*pack)) {
+        fprintf(stderr, "[bytee] %s is not a version %u pack, rebuild it with tools/pack_assets\n",
+                pack_path, PACK_VERSION);
+        unmap_file(*pack);
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(pack_mutex);
+    mounts.push_back(std::move(pack));
+    return true;
+}
+
+/*
+@brief, unmaps an archive mounted from pack_path. Pending async loads are
+        finished first, since their decoded pixels may point into it.
+        Residency reloads afterwards go to the original files.
+*/
+void unmount_pack(const char* pack_path) {
+    wait_for_assets();
+
+    std::unique_ptr<MountedPack> pack;
+    {
+        std::lock_guard<std::mutex> lock(pack_mutex);
+        for (auto it = mounts.rbegin(); it != mounts.rend(); ++it) {
+            if ((*it)->path != pack_path) continue;
+            pack = std::move(*it);
+            mounts.erase(std::next(it).base());
+            break;
+        }
+    }
+    if (pack) unmap_file(*pack);
+}
+
+/* @brief, true if a mounted archive holds path as an image or a font */
+bool pack_contains(const char* path) {
+    return pack_find(path, PACK_IMAGE, nullptr) || pack_find(path, PACK_FONT, nullptr);
+}
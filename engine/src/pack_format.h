@@ -0,0 +1,97 @@
+// Copyright (c) 2026- b0owl / Brennan Marx-Rennie. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to use,
+// copy, modify, and distribute the Software for NON-COMMERCIAL purposes only,
+// subject to the following conditions:
+//
+// 1. The above copyright notice and this permission notice shall be included
+//    in all copies or substantial portions of the Software.
+// 2. The Software may not be used for commercial purposes without prior
+//    written permission from the copyright holder.
+// 3. Commercial use includes, but is not limited to, selling the Software,
+//    using it in a commercial product, or using it to provide commercial services.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+
+#pragma once
+
+// Internal to the engine and tools/pack_assets.cpp: the on-disk layout of a
+// packed asset archive. Everything is little-endian and read in place from
+// the mapping, so the structs are fixed-size and every data block starts on
+// a PACK_ALIGN boundary.
+//
+//     PackHeader
+//     PackEntry[slot_count]   open-addressed hash table, linear probing
+//     names                   entry names, not NUL-terminated
+//     data blocks             image pixels, or PackFont + atlas bytes
+
+#include <stdint.h>
+
+static const char     PACK_MAGIC[4] = { 'B', 'P', 'A', 'K' };
+static const uint32_t PACK_VERSION  = 1;
+static const uint32_t PACK_ALIGN    = 16;
+
+// Bitmap font bake parameters; must match ATLAS_SIZE and BAKE_SIZE in
+// rendering.cpp, which rejects packed fonts baked with anything else.
+static const int   PACK_FONT_ATLAS_SIZE = 512;
+static const float PACK_FONT_BAKE_SIZE  = 64.0f;
+static const int   PACK_FONT_FIRST_CHAR = 32;
+static const int   PACK_FONT_CHAR_COUNT = 96;
+
+enum PackEntryType : uint32_t {
+    PACK_EMPTY = 0,  // unused hash slot
+    PACK_IMAGE = 1,  // width * height * channels bytes, as stb_image decodes them
+    PACK_FONT  = 2,  // PackFont, then width * height bytes of 1-channel atlas
+};
+
+struct PackHeader {
+    char     magic[4];
+    uint32_t version;
+    uint32_t slot_count;    // power of two
+    uint32_t entry_count;
+    uint64_t index_offset;  // slot_count PackEntry
+    uint64_t names_offset;
+    uint64_t file_size;
+};
+
+struct PackEntry {
+    uint64_t hash;          // pack_hash of the name
+    uint32_t type;          // PackEntryType
+    uint32_t name_offset;   // into the names block
+    uint32_t name_length;
+    int32_t  width, height; // image size, or atlas size for fonts
+    int32_t  channels;      // 1..4 for images, 1 for fonts
+    uint64_t data_offset;   // from the start of the file
+    uint64_t data_size;
+};
+
+// Same layout as stbtt_bakedchar.
+struct PackGlyph {
+    uint16_t x0, y0, x1, y1;
+    float    xoff, yoff, xadvance;
+};
+
+struct PackFont {
+    float     bake_size;
+    float     pixel_ascender;
+    int32_t   first_char;
+    int32_t   char_count;
+    PackGlyph glyphs[PACK_FONT_CHAR_COUNT];
+};
+
+static_assert(sizeof(PackHeader) == 40, "PackHeader layout");
+static_assert(sizeof(PackEntry) == 48, "PackEntry layout");
+static_assert(sizeof(PackFont) % PACK_ALIGN == 0, "PackFont keeps the atlas aligned");
+
+// FNV-1a over a normalized name (forward slashes, no leading "./").
+static inline uint64_t pack_hash(const char* name, size_t length) {
+    uint64_t hash = 14695981039346656037ull;
+    for (size_t i = 0; i < length; i++) {
+        hash ^= (unsigned char)name[i];
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
@@ -0,0 +1,378 @@
+// Copyright (c) 2026- b0owl / Brennan Marx-Rennie. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to use,
+// copy, modify, and distribute the Software for NON-COMMERCIAL purposes only,
+// subject to the following conditions:
+//
+// 1. The above copyright notice and this permission notice shall be included
+//    in all copies or substantial portions of the Software.
+// 2. The Software may not be used for commercial purposes without prior
+//    written permission from the copyright holder.
+// 3. Commercial use includes, but is not limited to, selling the Software,
+//    using it in a commercial product, or using it to provide commercial services.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+
+#include <GLFW/glfw3.h>
+#include <stdio.h>
+#include <chrono>
+#include <deque>
+#include <vector>
+#include "../include/profiler.h"
+#include "../include/gl_state.h"
+#include "gl_functions.h"
+#include "core_backend.h"
+#include "profiler_internal.h"
+
+static const int    PROFILER_MAX_DEPTH  = 64;
+static const size_t PROFILER_MAX_EVENTS = 1 << 20;  // ~32 MB of trace, then events are dropped
+static const size_t PROFILER_MAX_FRAMES = 1 << 16;  // ~18 min at 60 fps, then the oldest are dropped
+static const int    TID_CPU = 0;
+static const int    TID_GPU = 1;
+
+struct TraceEvent {
+    const char* name;
+    double ts;   // microseconds since the profiler was first enabled
+    double dur;
+    int tid;
+};
+
+struct OpenScope {
+    const char* name;
+    double start;
+    long long gpu;  // sequence number of its GpuScope, or -1
+};
+
+// A pair of GL_TIMESTAMP queries; `end` stays 0 until the scope closes.
+struct GpuScope {
+    const char* name;
+    GLuint begin, end;
+    int frame;
+    int depth;
+    double offset;   // CPU time minus GPU time when the scope was opened
+    bool abandoned;  // discarded while open; never gets an end query
+};
+
+struct FrameRecord {
+    ProfileFrame stats;
+    double end;
+};
+
+struct ProfileCounters {
+    int glyphs;
+    int cache_hits;
+    int cache_misses;
+};
+
+static bool enabled    = false;
+static bool gpu_timing = true;
+static bool started    = false;
+static std::chrono::steady_clock::time_point epoch;
+
+static std::vector<TraceEvent>  trace_events;
+static size_t                   dropped_events = 0;
+static std::deque<FrameRecord>  frames;           // the last PROFILER_MAX_FRAMES frames
+static int                      frames_base = 0;  // frame number of frames[0]
+static size_t                   dropped_frames = 0;
+static ProfileCounters          counters = {};
+static int                      frame_number = 0;
+static double                   frame_start = 0.0;
+
+static OpenScope scope_stack[PROFILER_MAX_DEPTH];
+static int       scope_depth = 0;
+
+// No GPU result yet; value-initialized so new fields start at zero.
+static ProfileFrame empty_frame() {
+    ProfileFrame f{};
+    f.gpu_ms = -1.0;
+    f.gpu_frame = -1;
+    return f;
+}
+
+static std::vector<GpuScope> gpu_pending;       // oldest first
+static long long             gpu_pending_base = 0;  // sequence number of gpu_pending[0]
+static std::vector<GLuint>   gpu_free_queries;
+static int                   gpu_depth = 0;
+static double                gpu_offset = 0.0;
+static bool                  gpu_calibrated = false;
+static int                   gpu_resolving_frame = -1;
+static double                gpu_resolving_ms = 0.0;
+static ProfileFrame          last_frame = empty_frame();
+
+static double now_us() {
+    return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - epoch).count();
+}
+
+static void record_event(const char* name, double ts, double dur, int tid) {
+    if (trace_events.size() >= PROFILER_MAX_EVENTS) { dropped_events++; return; }
+    trace_events.push_back(TraceEvent{ name, ts, dur, tid });
+}
+
+static bool gpu_available() {
+    return gpu_timing && !null_backend_active() && glfwGetCurrentContext() && gl_has_timer_queries();
+}
+
+static GLuint acquire_query() {
+    GLuint q = 0;
+    if (!gpu_free_queries.empty()) { q = gpu_free_queries.back(); gpu_free_queries.pop_back(); }
+    else bgl.GenQueries(1, &q);
+    return q;
+}
+
+/* @brief, pairs the GPU clock with the CPU clock so GPU events line up in the trace */
+static void calibrate_gpu() {
+    int64_t gpu_now = 0;
+    bgl.GetInteger64v(GL_TIMESTAMP, &gpu_now);
+    gpu_offset = now_us() - gpu_now / 1000.0;
+    gpu_calibrated = true;
+}
+
+/* @brief, starts a new session clock on first use */
+static void start_clock() {
+    if (started) return;
+    epoch = std::chrono::steady_clock::now();
+    started = true;
+}
+
+/* @brief, forgets the open scopes; their GPU queries are released once resolved */
+static void discard_open_scopes() {
+    int depth = scope_depth < PROFILER_MAX_DEPTH ? scope_depth : PROFILER_MAX_DEPTH;
+    for (int i = 0; i < depth; i++) {
+        if (scope_stack[i].gpu >= gpu_pending_base)
+            gpu_pending[(size_t)(scope_stack[i].gpu - gpu_pending_base)].abandoned = true;
+    }
+    scope_depth = 0;
+    gpu_depth = 0;
+}
+
+/* @brief, turns recording on or off. Open scopes are discarded either way. */
+void profiler_enable(bool on) {
+    start_clock();
+    if (on && !enabled) frame_start = now_us();
+    enabled = on;
+    discard_open_scopes();
+}
+
+bool profiler_enabled() {
+    return enabled;
+}
+
+/* @brief, GPU scopes need GL 3.3 or ARB_timer_query; on by default */
+void profiler_set_gpu_timing(bool on) {
+    gpu_timing = on;
+}
+
+/*
+@brief, opens a scope. Scopes nest and must be closed in order by profile_end.
+
+@param name, stored by pointer; use a string literal
+@param gpu,  also time the GPU work issued inside the scope with timer queries
+*/
+void profile_begin(const char* name, bool gpu) {
+    if (!enabled) return;
+    if (scope_depth >= PROFILER_MAX_DEPTH) { scope_depth++; return; }
+
+    OpenScope& scope = scope_stack[scope_depth++];
+    scope.name = name;
+    scope.gpu  = -1;
+    if (gpu && gpu_available()) {
+        if (!gpu_calibrated) calibrate_gpu();
+        GpuScope g = { name, acquire_query(), 0, frame_number, gpu_depth++, gpu_offset, false };
+        bgl.QueryCounter(g.begin, GL_TIMESTAMP);
+        scope.gpu = gpu_pending_base + (long long)gpu_pending.size();
+        gpu_pending.push_back(g);
+    }
+    scope.start = now_us();
+}
+
+/* @brief, closes the innermost open scope */
+void profile_end() {
+    if (scope_depth == 0) return;
+    double end = now_us();
+    if (scope_depth-- > PROFILER_MAX_DEPTH) return;
+
+    const OpenScope& scope = scope_stack[scope_depth];
+    record_event(scope.name, scope.start, end - scope.start, TID_CPU);
+    if (scope.gpu >= gpu_pending_base) {
+        GpuScope& g = gpu_pending[(size_t)(scope.gpu - gpu_pending_base)];
+        g.end = acquire_query();
+        bgl.QueryCounter(g.end, GL_TIMESTAMP);
+        gpu_depth--;
+    }
+}
+
+static void finish_gpu_frame() {
+    last_frame.gpu_ms    = gpu_resolving_ms;
+    last_frame.gpu_frame = gpu_resolving_frame;
+    int index = gpu_resolving_frame - frames_base;  // negative once the record was dropped
+    if (gpu_resolving_frame >= 0 && index >= 0 && index < (int)frames.size())
+        frames[index].stats.gpu_ms = gpu_resolving_ms;
+    gpu_resolving_frame = -1;
+    gpu_resolving_ms = 0.0;
+}
+
+/* @brief, reads back every finished GPU scope without stalling; the rest wait for a later frame */
+static void resolve_gpu_scopes() {
+    if (gpu_pending.empty() || !glfwGetCurrentContext()) return;
+
+    size_t done = 0;
+    for (; done < gpu_pending.size(); done++) {
+        const GpuScope& g = gpu_pending[done];
+        if (g.abandoned) { gpu_free_queries.push_back(g.begin); continue; }
+        if (!g.end) break;
+        GLint available = 0;
+        bgl.GetQueryObjectiv(g.end, GL_QUERY_RESULT_AVAILABLE, &available);
+        if (!available) break;
+
+        uint64_t t0 = 0, t1 = 0;
+        bgl.GetQueryObjectui64v(g.begin, GL_QUERY_RESULT, &t0);
+        bgl.GetQueryObjectui64v(g.end,   GL_QUERY_RESULT, &t1);
+        double dur = t1 > t0 ? (t1 - t0) / 1000.0 : 0.0;
+        record_event(g.name, t0 / 1000.0 + g.offset, dur, TID_GPU);
+
+        if (g.frame != gpu_resolving_frame) {
+            if (gpu_resolving_frame >= 0) finish_gpu_frame();
+            gpu_resolving_frame = g.frame;
+        }
+        if (g.depth == 0) gpu_resolving_ms += dur / 1000.0;
+
+        gpu_free_queries.push_back(g.begin);
+        gpu_free_queries.push_back(g.end);
+    }
+    gpu_pending.erase(gpu_pending.begin(), gpu_pending.begin() + done);
+    gpu_pending_base += (long long)done;
+    if (gpu_pending.empty() && gpu_resolving_frame >= 0) finish_gpu_frame();
+}
+
+/*
+@brief, closes the frame: snapshots the counters, collects finished GPU
+        results and starts the next frame. glCleanup calls this after
+        gls_end_frame; call both yourself if you don't use glCleanup.
+*/
+void profiler_end_frame() {
+    ProfileCounters c = counters;
+    counters = ProfileCounters{};
+    if (!enabled) return;
+
+    double now = now_us();
+    GLStateStats gs = gls_stats();
+
+    ProfileFrame f = {};
+    f.frame         = frame_number;
+    f.cpu_ms        = (now - frame_start) / 1000.0;
+    f.gpu_ms        = -1.0;
+    f.gpu_frame     = -1;
+    f.draw_calls    = gs.draw_calls;
+    f.texture_binds = gs.texture_binds;
+    f.state_changes = gs.changes;
+    f.vertices      = gs.vertices;
+    f.glyphs        = c.glyphs;
+    f.cache_hits    = c.cache_hits;
+    f.cache_misses  = c.cache_misses;
+    if (frames.size() >= PROFILER_MAX_FRAMES) {
+        frames.pop_front();
+        frames_base++;
+        dropped_frames++;
+    }
+    frames.push_back(FrameRecord{ f, now });
+    record_event("frame", frame_start, now - frame_start, TID_CPU);
+
+    resolve_gpu_scopes();
+    f.gpu_ms    = last_frame.gpu_ms;
+    f.gpu_frame = last_frame.gpu_frame;
+    last_frame  = f;
+
+    if (gpu_available()) calibrate_gpu();
+    frame_number++;
+    frame_start = now_us();
+}
+
+/* @brief, stats of the last completed frame */
+ProfileFrame profiler_last_frame() {
+    return last_frame;
+}
+
+static void write_json_string(FILE* f, const char* s) {
+    fputc('"', f);
+    for (; *s; s++) {
+        if (*s == '"' || *s == '\\') fputc('\\', f);
+        if ((unsigned char)*s < 0x20) fputc(' ', f);
+        else fputc(*s, f);
+    }
+    fputc('"', f);
+}
+
+/*
+@brief, writes everything recorded so far as Chrome trace event JSON, which
+        chrome://tracing and ui.perfetto.dev open directly. CPU scopes and GPU
+        scopes are on separate tracks; per-frame counters are counter tracks.
+
+@param path, output file
+@returns false if the file couldn't be written
+*/
+bool profiler_write_trace(const char* path) {
+    resolve_gpu_scopes();
+    FILE* f = fopen(path, "w");
+    if (!f) return false;
+
+    fprintf(f, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    fprintf(f, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"CPU\"}},\n", TID_CPU);
+    fprintf(f, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"GPU\"}}", TID_GPU);
+
+    for (const TraceEvent& e : trace_events) {
+        fprintf(f, ",\n{\"name\":");
+        write_json_string(f, e.name);
+        fprintf(f, ",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f}", e.tid, e.ts, e.dur);
+    }
+    for (const FrameRecord& r : frames) {
+        const ProfileFrame& s = r.stats;
+        fprintf(f, ",\n{\"name\":\"frame_ms\",\"ph\":\"C\",\"pid\":1,\"ts\":%.3f,\"args\":{\"cpu\":%.3f",
+                r.end, s.cpu_ms);
+        if (s.gpu_ms >= 0.0) fprintf(f, ",\"gpu\":%.3f", s.gpu_ms);
+        fprintf(f, "}}");
+        fprintf(f, ",\n{\"name\":\"draws\",\"ph\":\"C\",\"pid\":1,\"ts\":%.3f,\"args\":{\"draw_calls\":%d,"
+                   "\"texture_binds\":%d,\"state_changes\":%d}}", r.end, s.draw_calls, s.texture_binds, s.state_changes);
+        fprintf(f, ",\n{\"name\":\"geometry\",\"ph\":\"C\",\"pid\":1,\"ts\":%.3f,\"args\":{\"vertices\":%d,\"glyphs\":%d}}",
+                r.end, s.vertices, s.glyphs);
+        fprintf(f, ",\n{\"name\":\"cache\",\"ph\":\"C\",\"pid\":1,\"ts\":%.3f,\"args\":{\"hits\":%d,\"misses\":%d}}",
+                r.end, s.cache_hits, s.cache_misses);
+    }
+    fprintf(f, "\n]}\n");
+
+    if (dropped_events)
+        fprintf(stderr, "[bytee] profiler trace is full, %zu events were dropped\n", dropped_events);
+    if (dropped_frames)
+        fprintf(stderr, "[bytee] profiler kept the last %zu frames, %zu older ones were dropped\n",
+                frames.size(), dropped_frames);
+    return fclose(f) == 0;
+}
+
+/* @brief, drops every recorded event and frame and restarts the frame count */
+void profiler_clear() {
+    trace_events.clear();
+    frames.clear();
+    frames_base = 0;
+    dropped_frames = 0;
+    dropped_events = 0;
+    frame_number = 0;
+    last_frame = empty_frame();
+    // Queries still in flight just get reused; results for cleared frames are ignored.
+    for (const GpuScope& g : gpu_pending) {
+        gpu_free_queries.push_back(g.begin);
+        if (g.end) gpu_free_queries.push_back(g.end);
+    }
+    gpu_pending_base += (long long)gpu_pending.size();
+    gpu_pending.clear();
+    gpu_resolving_frame = -1;
+    gpu_resolving_ms = 0.0;
+    scope_depth = 0;
+    gpu_depth = 0;
+    if (enabled) frame_start = now_us();
+}
+
+void prof_count_glyphs(int glyphs) { counters.glyphs += glyphs; }
+void prof_cache_hit()               { counters.cache_hits++; }
+void prof_cache_miss()              { counters.cache_misses++; }
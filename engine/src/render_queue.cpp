@@ -0,0 +1,227 @@
+// Copyright (c) 2026- b0owl / Brennan Marx-Rennie. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to use,
+// copy, modify, and distribute the Software for NON-COMMERCIAL purposes only,
+// subject to the following conditions:
+//
+// 1. The above copyright notice and this permission notice shall be included
+//    in all copies or substantial portions of the Software.
+// 2. The Software may not be used for commercial purposes without prior
+//    written permission from the copyright holder.
+// 3. Commercial use includes, but is not limited to, selling the Software,
+//    using it in a commercial product, or using it to provide commercial services.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+
+#ifdef __APPLE__
+  #include <OpenGL/gl.h>
+#else
+  #include <GL/gl.h>
+#endif
+
+#include <stdint.h>
+#include <vector>
+#include "../include/allocator.h"
+#include "../include/rendering.h"
+#include "../include/batch.h"
+#include "../include/gl_state.h"
+#include "../include/render_queue.h"
+#include "../include/profiler.h"
+#include "render_queue_internal.h"
+
+// Sort key, most significant first. Bits 0..15 hold the texture name; GL
+// hands out small names, so truncating only matters for grouping, never for
+// correctness.
+static const int KEY_TEXTURE_SHIFT = 0;
+static const int KEY_SHADER_SHIFT  = 16;  // 1 bit, BatchShader
+static const int KEY_BLEND_SHIFT   = 17;  // 2 bits, BlendMode
+static const int KEY_DEPTH_SHIFT   = 19;  // 16 bits
+static const int KEY_LAYER_SHIFT   = 35;  // 8 bits, biased by 128
+static const int KEY_BITS          = 43;
+
+enum { CMD_QUAD, CMD_TEXT_MESH, CMD_SHAPES };
+
+struct RenderCmd {
+    uint64_t key;
+    int type;
+    int index;  // into the array for its type
+};
+
+struct QuadCmd {
+    unsigned int tex;
+    int shader;
+    float x0, y0, x1, y1;
+    float u0, v0, u1, v1;
+    float r, g, b, a;
+};
+
+struct TextMeshCmd {
+    const TextMesh* mesh;
+    float x, y, r, g, b;
+};
+
+struct ShapesCmd {
+    Allocator* owner;
+    void** ptr;
+    int count;
+};
+
+// Per-command state, set by render_set_*.
+static int current_layer = 0;
+static float current_depth = 0.0f;
+static BlendMode current_blend = BlendMode::Alpha;
+
+static bool queue_enabled = false;
+static bool queue_replaying = false;
+
+// All storage keeps its capacity between frames.
+static std::vector<RenderCmd> queue_cmds;
+static std::vector<RenderCmd> queue_scratch;
+static std::vector<QuadCmd> queue_quads;
+static std::vector<TextMeshCmd> queue_meshes;
+static std::vector<ShapesCmd> queue_shapes;
+
+void render_set_layer(int layer) {
+    current_layer = layer < -128 ? -128 : (layer > 127 ? 127 : layer);
+}
+
+void render_set_depth(float depth) {
+    current_depth = depth < 0.0f ? 0.0f : (depth > 1.0f ? 1.0f : depth);
+}
+
+void render_set_blend(BlendMode mode) { current_blend = mode; }
+
+int render_get_layer() { return current_layer; }
+float render_get_depth() { return current_depth; }
+BlendMode render_get_blend() { return current_blend; }
+
+/*
+@brief, turns command recording on or off. Turning it off flushes whatever
+        was recorded so far.
+*/
+void render_queue_enable(bool enabled) {
+    if (!enabled) render_queue_flush();
+    queue_enabled = enabled;
+}
+
+bool render_queue_enabled() { return queue_enabled; }
+
+int render_queue_size() { return (int)queue_cmds.size(); }
+
+bool render_queue_recording() {
+    return queue_enabled && !queue_replaying;
+}
+
+static uint64_t make_key(int shader, unsigned int tex) {
+    uint64_t layer = (uint64_t)(current_layer + 128);
+    uint64_t depth = (uint64_t)(current_depth * 65535.0f + 0.5f);
+    return (layer << KEY_LAYER_SHIFT) | (depth << KEY_DEPTH_SHIFT) |
+           ((uint64_t)current_blend << KEY_BLEND_SHIFT) |
+           ((uint64_t)(shader & 1) << KEY_SHADER_SHIFT) |
+           ((uint64_t)(tex & 0xFFFF) << KEY_TEXTURE_SHIFT);
+}
+
+void render_queue_push_quad(unsigned int tex, int shader,
+                            float x0, float y0, float x1, float y1,
+                            float u0, float v0, float u1, float v1,
+                            float r, float g, float b, float a) {
+    queue_cmds.push_back({ make_key(shader, tex), CMD_QUAD, (int)queue_quads.size() });
+    queue_quads.push_back({ tex, shader, x0, y0, x1, y1, u0, v0, u1, v1, r, g, b, a });
+}
+
+void render_queue_push_text_mesh(const TextMesh* mesh, float x, float y, float r, float g, float b) {
+    int shader = mesh->sdf ? BATCH_SHADER_SDF : BATCH_SHADER_DEFAULT;
+    queue_cmds.push_back({ make_key(shader, mesh->tex), CMD_TEXT_MESH, (int)queue_meshes.size() });
+    queue_meshes.push_back({ mesh, x, y, r, g, b });
+}
+
+void render_queue_push_shapes(Allocator* owner, void** ptr, int count) {
+    queue_cmds.push_back({ make_key(BATCH_SHADER_DEFAULT, 0), CMD_SHAPES, (int)queue_shapes.size() });
+    queue_shapes.push_back({ owner, ptr, count });
+}
+
+/*
+@brief, stable LSD radix sort on the key, 8 bits per pass. Passes where every
+        key has the same digit are skipped, which is most of them when only a
+        few layers and textures are in use.
+*/
+static void radix_sort(std::vector<RenderCmd>& cmds, std::vector<RenderCmd>& scratch) {
+    size_t n = cmds.size();
+    if (n < 2) return;
+    scratch.resize(n);
+    RenderCmd* src = cmds.data();
+    RenderCmd* dst = scratch.data();
+
+    for (int shift = 0; shift < KEY_BITS; shift += 8) {
+        size_t counts[256] = {};
+        for (size_t i = 0; i < n; i++) counts[(src[i].key >> shift) & 0xFF]++;
+        if (counts[(src[0].key >> shift) & 0xFF] == n) continue;
+
+        size_t offset = 0;
+        for (size_t& c : counts) { size_t k = c; c = offset; offset += k; }
+        for (size_t i = 0; i < n; i++) dst[counts[(src[i].key >> shift) & 0xFF]++] = src[i];
+        RenderCmd* t = src; src = dst; dst = t;
+    }
+    if (src != cmds.data()) cmds.swap(scratch);
+}
+
+/*
+@brief, sorts and draws everything recorded since the last flush, then
+        flushes the sprite batch. glCleanup calls this every frame; call it
+        yourself before raw GL that must draw on top of queued commands.
+        Safe to call with the queue off — it then only flushes the batch.
+*/
+void render_queue_flush() {
+    if (!queue_cmds.empty() && !queue_replaying) {
+        ProfileScope scope("render_queue_flush", true);
+        radix_sort(queue_cmds, queue_scratch);
+
+        int saved_layer = current_layer;
+        float saved_depth = current_depth;
+        BlendMode saved_blend = current_blend;
+        queue_replaying = true;
+
+        for (const RenderCmd& cmd : queue_cmds) {
+            // Draw paths read the blend mode from the current state.
+            current_blend = (BlendMode)((cmd.key >> KEY_BLEND_SHIFT) & 3);
+            if (cmd.type == CMD_QUAD) {
+                const QuadCmd& q = queue_quads[cmd.index];
+                batch_submit(q.tex, q.x0, q.y0, q.x1, q.y1, q.u0, q.v0, q.u1, q.v1,
+                             q.r, q.g, q.b, q.a, q.shader);
+            } else if (cmd.type == CMD_TEXT_MESH) {
+                const TextMeshCmd& m = queue_meshes[cmd.index];
+                draw_text_mesh(*m.mesh, m.x, m.y, m.r, m.g, m.b);
+            } else {
+                const ShapesCmd& s = queue_shapes[cmd.index];
+                s.owner->draw_struct(s.ptr, s.count);
+            }
+        }
+
+        queue_replaying = false;
+        current_layer = saved_layer;
+        current_depth = saved_depth;
+        current_blend = saved_blend;
+        queue_cmds.clear();
+        queue_quads.clear();
+        queue_meshes.clear();
+        queue_shapes.clear();
+    }
+    batch_flush();
+}
+
+/* @brief, current blend mode as an int, for the batch (see BlendMode) */
+int render_state_blend() {
+    return (int)current_blend;
+}
+
+/* @brief, sets the GL blend function for a BlendMode passed as an int */
+void render_apply_blend(int blend) {
+    switch ((BlendMode)blend) {
+        case BlendMode::Additive:      gls_blend_func(GL_SRC_ALPHA, GL_ONE); break;
+        case BlendMode::Premultiplied: gls_blend_func(GL_ONE, GL_ONE_MINUS_SRC_ALPHA); break;
+        default:                       gls_blend_func(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA); break;
+    }
+}
@@ -0,0 +1,39 @@
+// Copyright (c) 2026- b0owl / Brennan Marx-Rennie. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to use,
+// copy, modify, and distribute the Software for NON-COMMERCIAL purposes only,
+// subject to the following conditions:
+//
+// 1. The above copyright notice and this permission notice shall be included
+//    in all copies or substantial portions of the Software.
+// 2. The Software may not be used for commercial purposes without prior
+//    written permission from the copyright holder.
+// 3. Commercial use includes, but is not limited to, selling the Software,
+//    using it in a commercial product, or using it to provide commercial services.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+
+#pragma once
+
+// Internal to the engine: how draw paths hand commands to the render queue.
+// A draw path checks render_queue_recording() first; if it is true it pushes
+// a command and returns, otherwise it draws. During replay recording is off,
+// so the same draw path then draws for real with the command's state current.
+
+struct TextMesh;
+class Allocator;
+
+bool render_queue_recording();
+void render_queue_push_quad(unsigned int tex, int shader,
+                            float x0, float y0, float x1, float y1,
+                            float u0, float v0, float u1, float v1,
+                            float r, float g, float b, float a);
+void render_queue_push_text_mesh(const TextMesh* mesh, float x, float y, float r, float g, float b);
+void render_queue_push_shapes(Allocator* owner, void** ptr, int count);
+
+// The blend mode new draws use, as an int BlendMode.
+int render_state_blend();
+void render_apply_blend(int blend);
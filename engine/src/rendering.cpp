@@ -22,6 +22,10 @@
 #include <GLFW/glfw3.h>
 #endif
 
+// Pulls in the stb_truetype declarations; must come before the implementation
+// define below so the implementation is only compiled once.
+#include "rendering_internal.h"
+
 #define STB_IMAGE_IMPLEMENTATION
 #include "../vendor/stb_image.h"
 
@@ -29,18 +33,36 @@
 #include "../vendor/stb_truetype.h"
 
 #include <stdio.h>
+#include <string.h>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 #include <unordered_map>
 #include "../include/allocator.h"
 #include "../include/rendering.h"
+#include "../include/batch.h"
+#include "../include/gl_state.h"
+#include "../include/render_queue.h"
+#include "../include/profiler.h"
+#include "gl_functions.h"
+#include "render_queue_internal.h"
+#include "core_backend.h"
+#include "profiler_internal.h"
+#include "residency_internal.h"
+#include "pack_internal.h"
 
 /*
 @brief, Creates and returns an object with the information specified 
         upon calling this function. It will not store the object in 
         the memory allocator, you must do this manually by running
-        ALLOCATOR.store_ptr(INDEX, createobj(ARGS)). Note that vertex_c
-        is taken as a pointer to a list, such that a vector is not required
+        ALLOCATOR.store_ptr(createobj(ARGS)). The object lives in
+        draw_pool_default(), so consecutive objects sit next to each other
+        in memory; the Allocator returns it to the pool on destruction.
+        The result is NOT a new'd object and must never be deleted; free
+        one you own yourself with release_draw_data(obj).
+        Note that vertex_c is taken as a pointer to a list, such that a
+        vector is not required
 
 @param vertex_c, array of vertex coordinates (not to be confused with X,Y args),
        these only specify the distance from one vertex to another
@@ -53,71 +75,263 @@
 DrawData* createobj(const float* vertex_c, int vertex_count, float X, float Y, 
                     float R, float G, float B) 
 {
-    DrawData* sprite = new DrawData{};
-    sprite->vertex_count = vertex_count;
-    
-    // Copy all vertex data (vertex_count * 2 floats)
-    for (int i = 0; i < vertex_count * 2; i++) {
-        sprite->vertices[i] = vertex_c[i];
+    return draw_pool_default().create(vertex_c, vertex_count, X, Y, R, G, B);
+}
+
+// --- Texture cache -----------------------------------------------------------
+
+// Images and spritesheets share one cache, so a file is only ever decoded and
+// uploaded once no matter which API loaded it.
+static std::unordered_map<std::string, SheetEntry> sheet_cache;
+
+// Guards sheet_cache and font_cache so the async loader can look entries up
+// from worker threads. Never held across GL calls or decoding.
+static std::mutex cache_mutex;
+
+// Defaults for loads that don't pass their own TextureOptions.
+static TextureOptions texture_options;
+
+static int mip_levels(int img_w, int img_h) {
+    int levels = 1;
+    for (int size = img_w > img_h ? img_w : img_h; size > 1; size >>= 1) levels++;
+    return levels;
+}
+
+// GPU bytes of a texture uploaded with options. RGB8 counts as 4 bytes per
+// texel since drivers pad it; a mip chain adds a third.
+static size_t texture_bytes(int img_w, int img_h, const TextureOptions& options) {
+    size_t bytes = (size_t)img_w * img_h * (options.format == TextureFormat::Auto ? 4 : 2);
+    return options.mipmaps ? bytes + bytes / 3 : bytes;
+}
+
+static unsigned short pack_texel(const unsigned char* px, int channels, TextureFormat format) {
+    unsigned char a = channels == 4 ? px[3] : 255;
+    if (format == TextureFormat::RGB565) {
+        return (unsigned short)(((px[0] * 31 + 127) / 255) << 11 |
+                                ((px[1] * 63 + 127) / 255) << 5 |
+                                ((px[2] * 31 + 127) / 255));
     }
-    
-    sprite->r = R;
-    sprite->g = G;
-    sprite->b = B;
-    sprite->x = X;
-    sprite->y = Y;
-    
-    return sprite;
+    return (unsigned short)(((px[0] * 15 + 127) / 255) << 12 |
+                            ((px[1] * 15 + 127) / 255) << 8 |
+                            ((px[2] * 15 + 127) / 255) << 4 |
+                            ((a     * 15 + 127) / 255));
 }
 
-unsigned int draw_image(const char* filepath, float x, float y, float w, float h, float* out_corrected_w) {
-    int img_w, img_h, channels;
-    unsigned char* data = stbi_load(filepath, &img_w, &img_h, &channels, 0);
-    if (!data) return 0;
+// Applies premultiply and 16-bit packing on the CPU, so the driver gets the
+// final texels and the upload itself shrinks. Returns data when nothing changes.
+static const void* convert_texels(const unsigned char* data, int texels, int channels,
+                                  const TextureOptions& options, std::vector<unsigned char>& scratch) {
+    bool premultiply = options.premultiply && channels == 4;
+    if (!premultiply && options.format == TextureFormat::Auto) return data;
+
+    const unsigned char* src = data;
+    if (premultiply) {
+        scratch.assign(data, data + (size_t)texels * 4);
+        for (int i = 0; i < texels; i++) {
+            unsigned char* px = &scratch[i * 4];
+            px[0] = (unsigned char)((px[0] * px[3] + 127) / 255);
+            px[1] = (unsigned char)((px[1] * px[3] + 127) / 255);
+            px[2] = (unsigned char)((px[2] * px[3] + 127) / 255);
+        }
+        src = scratch.data();
+    }
+    if (options.format == TextureFormat::Auto) return src;
 
-    // Correct for image aspect ratio.
-    // glOrtho(-aspect, aspect, -1, 1, ...) makes 1 world-unit equal in both axes,
-    // so no viewport aspect correction is needed here.
-    float img_aspect = (float)img_w / (float)img_h;
-    float corrected_w = w * img_aspect;
-    if (out_corrected_w) *out_corrected_w = corrected_w;
+    std::vector<unsigned char> packed((size_t)texels * 2);
+    unsigned short* out = (unsigned short*)packed.data();
+    for (int i = 0; i < texels; i++) out[i] = pack_texel(src + i * channels, channels, options.format);
+    scratch.swap(packed);
+    return scratch.data();
+}
 
-    unsigned int tex;
-    glGenTextures(1, &tex);
-    glBindTexture(GL_TEXTURE_2D, tex);
+// Uploads into tex, or into a new texture when tex is 0 (reloads keep their name).
+static unsigned int upload_texture(const unsigned char* data, int img_w, int img_h, int channels,
+                                   const TextureOptions& options, unsigned int tex = 0) {
+    if (!tex) tex = gls_gen_texture();
+    if (null_backend_active()) return tex;
+    gls_bind_texture(tex);
 
     GLenum format = (channels == 4) ? GL_RGBA : GL_RGB;
+    GLenum internal_format = format;
+    GLenum type = GL_UNSIGNED_BYTE;
+    if (options.format == TextureFormat::RGB565) {
+        format = GL_RGB;  internal_format = GL_RGB5;  type = GL_UNSIGNED_SHORT_5_6_5;
+    } else if (options.format == TextureFormat::RGBA4444) {
+        format = GL_RGBA; internal_format = GL_RGBA4; type = GL_UNSIGNED_SHORT_4_4_4_4;
+    }
+    std::vector<unsigned char> scratch;
+    const void* texels = convert_texels(data, img_w * img_h, channels, options, scratch);
+
+    bool generate = options.mipmaps && gl_has_generate_mipmap();
+    bool automatic = options.mipmaps && !generate && gl_has_auto_mipmap();
+    if (gl_has_auto_mipmap()) glTexParameteri(GL_TEXTURE_2D, GL_GENERATE_MIPMAP, automatic ? GL_TRUE : GL_FALSE);
+
     glPixelStorei(GL_UNPACK_ALIGNMENT, 1);  // prevent row-shearing on non-4-byte-aligned RGB images
-    glTexImage2D(GL_TEXTURE_2D, 0, format, img_w, img_h, 0, format, GL_UNSIGNED_BYTE, data);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexImage2D(GL_TEXTURE_2D, 0, internal_format, img_w, img_h, 0, format, type, texels);
+    if (generate) bgl.GenerateMipmap(GL_TEXTURE_2D);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER,
+                    generate || automatic ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    return tex;
+}
 
-    stbi_image_free(data);
+bool decode_image(const char* filepath, DecodedImage& out) {
+    const unsigned char* packed = nullptr;
+    if (const PackEntry* entry = pack_find(filepath, PACK_IMAGE, &packed)) {
+        out.pixels = (unsigned char*)packed;
+        out.img_w = entry->width;
+        out.img_h = entry->height;
+        out.channels = entry->channels;
+        out.mapped = true;
+        return true;
+    }
+    out.pixels = stbi_load(filepath, &out.img_w, &out.img_h, &out.channels, 0);
+    out.mapped = false;
+    return out.pixels != nullptr;
+}
 
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-    glEnable(GL_TEXTURE_2D);
-    glBindTexture(GL_TEXTURE_2D, tex);
-    glColor4f(1.0f, 1.0f, 1.0f, 1.0f);
+void free_decoded_image(DecodedImage& image) {
+    if (!image.mapped) stbi_image_free(image.pixels);
+    image.pixels = nullptr;
+}
 
-    glBegin(GL_TRIANGLE_FAN);
-        glTexCoord2f(0.0f, 1.0f); glVertex2f(x,               y);
-        glTexCoord2f(1.0f, 1.0f); glVertex2f(x + corrected_w, y);
-        glTexCoord2f(1.0f, 0.0f); glVertex2f(x + corrected_w, y + h);
-        glTexCoord2f(0.0f, 0.0f); glVertex2f(x,               y + h);
-    glEnd();
+const SheetEntry* find_cached_texture(const std::string& filepath) {
+    std::lock_guard<std::mutex> lock(cache_mutex);
+    auto it = sheet_cache.find(filepath);
+    return it != sheet_cache.end() ? &it->second : nullptr;
+}
 
-    glDisable(GL_TEXTURE_2D);
-    glDisable(GL_BLEND);
-    return tex;
+// Residency reload for an evicted texture; see residency.cpp.
+static bool reload_texture(const std::string& filepath, unsigned int tex) {
+    const SheetEntry* entry = find_cached_texture(filepath);
+    DecodedImage image;
+    if (!entry || !decode_image(filepath.c_str(), image)) return false;
+    upload_texture(image.pixels, image.img_w, image.img_h, image.channels, entry->options, tex);
+    free_decoded_image(image);
+    return true;
 }
 
-// --- Spritesheet -------------------------------------------------------------
+const SheetEntry* cache_texture(const std::string& filepath, const DecodedImage& image,
+                                const TextureOptions& options) {
+    if (const SheetEntry* existing = find_cached_texture(filepath)) return existing;
+
+    unsigned int tex = upload_texture(image.pixels, image.img_w, image.img_h, image.channels, options);
+    const SheetEntry* cached;
+    {
+        std::lock_guard<std::mutex> lock(cache_mutex);
+        SheetEntry& entry = sheet_cache[filepath];
+        entry = { tex, image.img_w, image.img_h, options };
+        cached = &entry;
+    }
+    residency_track(tex, filepath, texture_bytes(image.img_w, image.img_h, options), reload_texture,
+                    options.mipmaps ? mip_levels(image.img_w, image.img_h) : 1);
+    return cached;
+}
 
-struct SheetEntry { unsigned int tex; int img_w, img_h; };
-static std::unordered_map<std::string, SheetEntry> sheet_cache;
+// Returns the cached entry for filepath, decoding and uploading it on a miss.
+static const SheetEntry* load_texture(const char* filepath, const TextureOptions& options) {
+    if (const SheetEntry* entry = find_cached_texture(filepath)) { prof_cache_hit(); return entry; }
+    prof_cache_miss();
+    PROFILE_SCOPE("load_texture");
+
+    DecodedImage image;
+    if (!decode_image(filepath, image)) return nullptr;
+    const SheetEntry* entry = cache_texture(filepath, image, options);
+    free_decoded_image(image);
+    return entry;
+}
+
+/*
+@brief, sets the upload options used by loads that don't pass their own.
+        Already cached textures keep the options they were loaded with.
+*/
+void set_texture_options(const TextureOptions& options) {
+    texture_options = options;
+}
+
+TextureOptions get_texture_options() {
+    return texture_options;
+}
+
+// --- Images ------------------------------------------------------------------
+
+/*
+@brief, loads an image and caches the GL texture. Subsequent calls with the
+        same filepath return the cached texture without touching the disk.
+
+@param filepath, path to the image file
+@returns an Image ready to pass to draw_image, or { 0, 0, 0 } on failure
+*/
+Image load_image(const char* filepath) {
+    return load_image(filepath, texture_options);
+}
+
+/*
+@brief, load_image with explicit upload options. The options only apply if
+        this call uploads the texture; a cached path keeps its own.
+*/
+Image load_image(const char* filepath, const TextureOptions& options) {
+    const SheetEntry* entry = load_texture(filepath, options);
+    if (!entry) return { 0, 0, 0 };
+    return { entry->tex, entry->img_w, entry->img_h };
+}
+
+/*
+@brief, deletes the cached texture for filepath, if any. Every Image or
+        SpriteSheet loaded from that file is invalid afterwards.
+*/
+void unload_image(const char* filepath) {
+    unsigned int tex;
+    {
+        std::lock_guard<std::mutex> lock(cache_mutex);
+        auto it = sheet_cache.find(filepath);
+        if (it == sheet_cache.end()) return;
+        tex = it->second.tex;
+        sheet_cache.erase(it);
+    }
+    render_queue_flush();  // pending quads may still sample this texture
+    residency_untrack(tex);
+    gls_delete_texture(tex);
+}
+
+/*
+@brief, draws a loaded image. Costs one quad in the sprite batch.
+
+@param image,          Image returned by load_image
+@param x/y,            bottom-left corner in world coordinates
+@param w/h,            desired height in world units; width is corrected for the
+                       image aspect ratio automatically
+@param out_corrected_w optional; written with the actual rendered width
+*/
+void draw_image(Image image, float x, float y, float w, float h, float* out_corrected_w) {
+    if (!image.tex) return;
+    residency_touch(image.tex);
+
+    // Correct for image aspect ratio.
+    // glOrtho(-aspect, aspect, -1, 1, ...) makes 1 world-unit equal in both axes,
+    // so no viewport aspect correction is needed here.
+    float img_aspect = (float)image.img_w / (float)image.img_h;
+    float corrected_w = w * img_aspect;
+    if (out_corrected_w) *out_corrected_w = corrected_w;
+
+    batch_submit(image.tex, x, y, x + corrected_w, y + h, image.u0, image.v1, image.u1, image.v0);
+}
+
+/*
+@brief, convenience wrapper: load_image + draw_image. The texture is cached by
+        path, so calling this every frame no longer decodes or uploads.
+
+@returns the GL texture ID, or 0 if the image could not be loaded
+*/
+unsigned int draw_image(const char* filepath, float x, float y, float w, float h, float* out_corrected_w) {
+    Image image = load_image(filepath);
+    draw_image(image, x, y, w, h, out_corrected_w);
+    return image.tex;
+}
+
+// --- Spritesheet -------------------------------------------------------------
 
 /*
 @brief, loads a spritesheet image and caches the GL texture.
@@ -130,37 +344,19 @@ static std::unordered_map<std::string, SheetEntry> sheet_cache;
 @returns a SpriteSheet ready to pass to draw_sprite
 */
 SpriteSheet load_spritesheet(const char* filepath, int cols, int rows) {
-    SpriteSheet ss = { 0, 0, 0, cols, rows };
-
-    auto it = sheet_cache.find(filepath);
-    if (it != sheet_cache.end()) {
-        ss.tex   = it->second.tex;
-        ss.img_w = it->second.img_w;
-        ss.img_h = it->second.img_h;
-        return ss;
-    }
-
-    int img_w, img_h, channels;
-    unsigned char* data = stbi_load(filepath, &img_w, &img_h, &channels, 0);
-    if (!data) return ss;
+    return load_spritesheet(filepath, cols, rows, texture_options);
+}
 
-    ss.img_w = img_w;
-    ss.img_h = img_h;
+/* @brief, load_spritesheet with explicit upload options (see load_image) */
+SpriteSheet load_spritesheet(const char* filepath, int cols, int rows, const TextureOptions& options) {
+    SpriteSheet ss = { 0, 0, 0, cols, rows };
 
-    unsigned int tex;
-    glGenTextures(1, &tex);
-    glBindTexture(GL_TEXTURE_2D, tex);
-    GLenum format = (channels == 4) ? GL_RGBA : GL_RGB;
-    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
-    glTexImage2D(GL_TEXTURE_2D, 0, format, img_w, img_h, 0, format, GL_UNSIGNED_BYTE, data);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-    stbi_image_free(data);
+    const SheetEntry* entry = load_texture(filepath, options);
+    if (!entry) return ss;
 
-    sheet_cache[filepath] = { tex, img_w, img_h };
-    ss.tex = tex;
+    ss.tex   = entry->tex;
+    ss.img_w = entry->img_w;
+    ss.img_h = entry->img_h;
     return ss;
 }
 
@@ -177,6 +373,7 @@ SpriteSheet load_spritesheet(const char* filepath, int cols, int rows) {
 */
 void draw_sprite(SpriteSheet sheet, int frame, float x, float y, float w, float h, float* out_corrected_w) {
     if (!sheet.tex) return;
+    residency_touch(sheet.tex);
 
     float cell_aspect = (float)(sheet.img_w * sheet.rows) / (float)(sheet.img_h * sheet.cols);
     float corrected_w = w * cell_aspect;
@@ -184,26 +381,15 @@ void draw_sprite(SpriteSheet sheet, int frame, float x, float y, float w, float
 
     int col = frame % sheet.cols;
     int row = frame / sheet.cols;
-    float u0 = (float)col       / sheet.cols;
-    float u1 = (float)(col + 1) / sheet.cols;
-    float v0 = (float)row       / sheet.rows;
-    float v1 = (float)(row + 1) / sheet.rows;
-
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-    glEnable(GL_TEXTURE_2D);
-    glBindTexture(GL_TEXTURE_2D, sheet.tex);
-    glColor4f(1.0f, 1.0f, 1.0f, 1.0f);
-
-    glBegin(GL_TRIANGLE_FAN);
-        glTexCoord2f(u0, v1); glVertex2f(x,               y);
-        glTexCoord2f(u1, v1); glVertex2f(x + corrected_w, y);
-        glTexCoord2f(u1, v0); glVertex2f(x + corrected_w, y + h);
-        glTexCoord2f(u0, v0); glVertex2f(x,               y + h);
-    glEnd();
-
-    glDisable(GL_TEXTURE_2D);
-    glDisable(GL_BLEND);
+    float cell_u = (sheet.u1 - sheet.u0) / sheet.cols;
+    float cell_v = (sheet.v1 - sheet.v0) / sheet.rows;
+    float u0 = sheet.u0 + cell_u * col;
+    float u1 = sheet.u0 + cell_u * (col + 1);
+    float v0 = sheet.v0 + cell_v * row;
+    float v1 = sheet.v0 + cell_v * (row + 1);
+
+    // Queued, not drawn — see batch.h. Texture v runs top-down, world y bottom-up.
+    batch_submit(sheet.tex, x, y, x + corrected_w, y + h, u0, v1, u1, v0);
 }
 
 // --- Text rendering ----------------------------------------------------------
@@ -211,107 +397,350 @@ void draw_sprite(SpriteSheet sheet, int frame, float x, float y, float w, float
 static const int ATLAS_SIZE  = 512;
 static const float BAKE_SIZE = 64.0f;  // font is baked at this px height
 
-struct BakedFont {
-    unsigned int tex;
-    stbtt_bakedchar chars[96];  // ASCII 32–127
-    float pixel_ascender;       // ascender in pixels at BAKE_SIZE
-};
-
-
-// sorry about readability
-// Store BakedFont as heap pointer so the address is stable across map rehashes.
-static std::unordered_map<std::string, BakedFont*> font_cache;
+// Store BakedFont on the heap so the address is stable across map rehashes.
+static std::unordered_map<std::string, std::unique_ptr<BakedFont>> font_cache;
+static FontMode font_mode = FontMode::Bitmap;
+// Bumped by unload_font, so TextMeshes know their atlas texture is gone.
+static unsigned int font_unloads = 0;
+
+// A packed atlas is used as is when it was baked with the same parameters.
+static bool find_packed_font(const char* font_path, DecodedFont& out) {
+    const unsigned char* data = nullptr;
+    const PackEntry* entry = pack_find(font_path, PACK_FONT, &data);
+    if (!entry) return false;
+
+    const PackFont* font = (const PackFont*)data;
+    if (entry->width != ATLAS_SIZE || entry->height != ATLAS_SIZE || font->bake_size != BAKE_SIZE ||
+        font->first_char != 32 || font->char_count != 96) {
+        fprintf(stderr, "[bytee] packed font %s was baked with other settings, baking it again\n", font_path);
+        return false;
+    }
+    static_assert(sizeof(PackGlyph) == sizeof(stbtt_bakedchar), "PackGlyph layout");
+    memcpy(out.chars, font->glyphs, sizeof(out.chars));
+    out.pixel_ascender = font->pixel_ascender;
+    out.mapped = data + sizeof(PackFont);
+    return true;
+}
 
-static BakedFont* load_font(const char* font_path) {
-    auto it = font_cache.find(font_path);
-    if (it != font_cache.end()) return it->second;
+bool bake_font(const char* font_path, DecodedFont& out) {
+    if (find_packed_font(font_path, out)) return true;
 
     FILE* f = fopen(font_path, "rb");
-    if (!f) return nullptr;
+    if (!f) return false;
     fseek(f, 0, SEEK_END);
     std::vector<unsigned char> buf(ftell(f));
     rewind(f);
-    fread(buf.data(), 1, buf.size(), f);
+    size_t read = fread(buf.data(), 1, buf.size(), f);
     fclose(f);
+    if (read != buf.size()) return false;
 
-    std::vector<unsigned char> bitmap(ATLAS_SIZE * ATLAS_SIZE);
-    BakedFont* baked = new BakedFont();
-    stbtt_BakeFontBitmap(buf.data(), 0, BAKE_SIZE, bitmap.data(),
-                         ATLAS_SIZE, ATLAS_SIZE, 32, 96, baked->chars);
+    out.bitmap.assign(ATLAS_SIZE * ATLAS_SIZE, 0);
+    stbtt_BakeFontBitmap(buf.data(), 0, BAKE_SIZE, out.bitmap.data(),
+                         ATLAS_SIZE, ATLAS_SIZE, 32, 96, out.chars);
 
     stbtt_fontinfo info;
-    stbtt_InitFont(&info, buf.data(), 0);
+    if (!stbtt_InitFont(&info, buf.data(), 0)) return false;
     int asc, desc, lg;
     stbtt_GetFontVMetrics(&info, &asc, &desc, &lg);
     float font_scale = stbtt_ScaleForPixelHeight(&info, BAKE_SIZE);
-    baked->pixel_ascender = asc * font_scale;
-
-    // Expand 1-channel bitmap to RGBA — alpha = bitmap value, RGB = 255.
-    // GL_ALPHA as internal format is unreliable on macOS; GL_RGBA is not.
-    std::vector<unsigned char> rgba(ATLAS_SIZE * ATLAS_SIZE * 4);
-    for (int i = 0; i < ATLAS_SIZE * ATLAS_SIZE; i++) {
-        rgba[i*4+0] = rgba[i*4+1] = rgba[i*4+2] = 255;
-        rgba[i*4+3] = bitmap[i];
-    }
+    out.pixel_ascender = asc * font_scale;
+    return true;
+}
+
+BakedFont* find_cached_font(const std::string& font_path) {
+    std::lock_guard<std::mutex> lock(cache_mutex);
+    auto it = font_cache.find(font_path);
+    return it != font_cache.end() ? it->second.get() : nullptr;
+}
+
+// --- Coverage textures -------------------------------------------------------
+
+static const GLint ALPHA_SWIZZLE[4] = { GL_ONE, GL_ONE, GL_ONE, GL_RED };
+
+// How coverage texels are stored. R8 needs a shader to read it: fixed-function
+// texture environments ignore swizzled alpha on GL_RED textures, so
+// compatibility contexts get luminance-alpha. GL_ALPHA as internal format is
+// unreliable on macOS and gone from core profiles, and core contexts without
+// swizzle (3.2) fall back to RGBA.
+enum AlphaFormat { ALPHA_R8 = 1, ALPHA_LA8 = 2, ALPHA_RGBA8 = 4 };
+
+static AlphaFormat alpha_format() {
+    if (!gl_core_context()) return ALPHA_LA8;
+    return gl_has_texture_swizzle() ? ALPHA_R8 : ALPHA_RGBA8;
+}
+
+// Expands coverage to the layout format needs, white with alpha = coverage.
+static const unsigned char* expand_alpha(const unsigned char* alpha, int texels, AlphaFormat format,
+                                         std::vector<unsigned char>& out) {
+    if (format == ALPHA_R8) return alpha;
+    out.assign((size_t)texels * format, 255);
+    for (int i = 0; i < texels; i++) out[i * format + format - 1] = alpha[i];
+    return out.data();
+}
+
+static GLenum alpha_gl_format(AlphaFormat format) {
+    return format == ALPHA_R8 ? GL_RED : format == ALPHA_LA8 ? GL_LUMINANCE_ALPHA : GL_RGBA;
+}
+
+void upload_alpha_texture(int w, int h, const unsigned char* alpha) {
+    AlphaFormat format = alpha_format();
+    GLenum gl_format = alpha_gl_format(format);
+    GLenum internal_format = format == ALPHA_R8 ? GL_R8 : format == ALPHA_LA8 ? GL_LUMINANCE8_ALPHA8 : GL_RGBA8;
+    if (format == ALPHA_R8) glTexParameteriv(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_RGBA, ALPHA_SWIZZLE);
+
+    std::vector<unsigned char> texels;
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTexImage2D(GL_TEXTURE_2D, 0, internal_format, w, h, 0, gl_format, GL_UNSIGNED_BYTE,
+                 expand_alpha(alpha, w * h, format, texels));
+}
+
+void upload_alpha_subimage(int x, int y, int w, int h, const unsigned char* alpha) {
+    AlphaFormat format = alpha_format();
+    std::vector<unsigned char> texels;
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTexSubImage2D(GL_TEXTURE_2D, 0, x, y, w, h, alpha_gl_format(format), GL_UNSIGNED_BYTE,
+                    expand_alpha(alpha, w * h, format, texels));
+}
 
-    glGenTextures(1, &baked->tex);
-    glBindTexture(GL_TEXTURE_2D, baked->tex);
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, ATLAS_SIZE, ATLAS_SIZE,
-                 0, GL_RGBA, GL_UNSIGNED_BYTE, rgba.data());
+size_t alpha_texture_bytes(int w, int h) {
+    return (size_t)w * h * (null_backend_active() ? ALPHA_RGBA8 : alpha_format());
+}
+
+static void upload_font_atlas(const DecodedFont& font, unsigned int tex) {
+    if (null_backend_active()) return;
+    gls_bind_texture(tex);
+    upload_alpha_texture(ATLAS_SIZE, ATLAS_SIZE, font.mapped ? font.mapped : font.bitmap.data());
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+}
+
+// Residency reload for an evicted font atlas; glyph metrics never leave the CPU.
+static bool reload_font(const std::string& font_path, unsigned int tex) {
+    DecodedFont font;
+    if (!bake_font(font_path.c_str(), font)) return false;
+    upload_font_atlas(font, tex);
+    return true;
+}
+
+BakedFont* cache_font(const std::string& font_path, const DecodedFont& font) {
+    if (BakedFont* existing = find_cached_font(font_path)) return existing;
+
+    std::unique_ptr<BakedFont> baked(new BakedFont());
+    memcpy(baked->chars, font.chars, sizeof(baked->chars));
+    baked->pixel_ascender = font.pixel_ascender;
+    baked->tex = gls_gen_texture();
+    upload_font_atlas(font, baked->tex);
+    residency_track(baked->tex, font_path, alpha_texture_bytes(ATLAS_SIZE, ATLAS_SIZE), reload_font);
+
+    std::lock_guard<std::mutex> lock(cache_mutex);
+    BakedFont* raw = baked.get();
+    font_cache[font_path] = std::move(baked);
+    return raw;
+}
+
+/*
+@brief, frees the baked bitmap font for font_path and its texture, if cached.
+        TextMeshes built from it must be rebuilt before they are drawn again;
+        build_text_mesh does so even when font, text and size are unchanged.
+*/
+void unload_font(const char* font_path) {
+    std::unique_ptr<BakedFont> font;
+    {
+        std::lock_guard<std::mutex> lock(cache_mutex);
+        auto it = font_cache.find(font_path);
+        if (it == font_cache.end()) return;
+        font = std::move(it->second);
+        font_cache.erase(it);
+    }
+    render_queue_flush();  // pending glyphs may still sample this texture
+    residency_untrack(font->tex);
+    gls_delete_texture(font->tex);
+    font_unloads++;
+}
+
+static BakedFont* load_font(const char* font_path) {
+    if (BakedFont* font = find_cached_font(font_path)) { prof_cache_hit(); return font; }
+    prof_cache_miss();
+    PROFILE_SCOPE("bake_font");
+
+    DecodedFont decoded;
+    if (!bake_font(font_path, decoded)) return nullptr;
+    return cache_font(font_path, decoded);
+}
+
+/*
+@brief, selects how text is rasterized from now on. Bitmap is the default.
+        Switching doesn't free anything; both caches keep their fonts.
+*/
+void set_font_mode(FontMode mode) {
+    font_mode = mode;
+}
 
-    font_cache[font_path] = baked;
-    return baked;
+FontMode get_font_mode() {
+    return font_mode;
 }
 
 /*
 @brief, renders a string of text using a TTF font.
         Font atlases are cached — the TTF is only loaded once per path.
+        Glyphs go through the sprite batch, so consecutive draw_text calls
+        with the same font share one draw call. There is no length limit.
 
 @param font_path, path to a .ttf file
-@param text, the string to draw
+@param text, the string to draw (ASCII; UTF-8 in FontMode::SDF)
 @param x/y, bottom-left origin in GL world coordinates
 @param size, height in world units (e.g. 0.05 = 5% of screen height)
 @param r/g/b, text color
 */
 void draw_text(const char* font_path, const char* text,
                float x, float y, float size, float r, float g, float b) {
+    if (font_mode == FontMode::SDF) { sdf_draw_text(font_path, text, x, y, size, r, g, b); return; }
+
     BakedFont* font = load_font(font_path);
     if (!font) return;
+    residency_touch(font->tex);
 
     float scale = size / BAKE_SIZE;
-
-    // Precompute all quads before touching GL state — stbtt must not be
-    // called between glBegin/glEnd (undefined behaviour on macOS drivers).
-    stbtt_aligned_quad quads[128];
-    int quad_count = 0;
     float cx = 0.0f, cy = 0.0f;
-    for (const char* p = text; *p && quad_count < 128; p++) {
+    int glyphs = 0;
+    for (const char* p = text; *p; p++) {
         if (*p < 32 || *p > 127) continue;
-        stbtt_GetBakedQuad(font->chars, ATLAS_SIZE, ATLAS_SIZE,
-                           *p - 32, &cx, &cy, &quads[quad_count++], 1);
+        stbtt_aligned_quad q;
+        stbtt_GetBakedQuad(font->chars, ATLAS_SIZE, ATLAS_SIZE, *p - 32, &cx, &cy, &q, 1);
+        // convert pixel offsets to world coords; flip Y (stbtt is top-down)
+        batch_submit(font->tex, x + q.x0 * scale, y - q.y1 * scale,
+                                x + q.x1 * scale, y - q.y0 * scale,
+                     q.s0, q.t1, q.s1, q.t0, r, g, b, 1.0f);
+        glyphs++;
     }
+    prof_count_glyphs(glyphs);
+}
 
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-    glEnable(GL_TEXTURE_2D);
-    glBindTexture(GL_TEXTURE_2D, font->tex);
-    glColor3f(r, g, b);
+// --- Text meshes -------------------------------------------------------------
 
-    glBegin(GL_QUADS);
-    for (int i = 0; i < quad_count; i++) {
-        const stbtt_aligned_quad& q = quads[i];
-        // convert pixel offsets to world coords; flip Y (stbtt is top-down)
-        glTexCoord2f(q.s0, q.t0); glVertex2f(x + q.x0 * scale, y - q.y0 * scale);
-        glTexCoord2f(q.s1, q.t0); glVertex2f(x + q.x1 * scale, y - q.y0 * scale);
-        glTexCoord2f(q.s1, q.t1); glVertex2f(x + q.x1 * scale, y - q.y1 * scale);
-        glTexCoord2f(q.s0, q.t1); glVertex2f(x + q.x0 * scale, y - q.y1 * scale);
+/*
+@brief, lays out a string into a cached vertex buffer. Does nothing if the
+        font, text and size are unchanged since the last call, so it is safe
+        to call every frame with the current string. In FontMode::SDF the
+        mesh is also rebuilt after the glyph atlas evicts anything, so keep
+        calling it every frame for SDF meshes. Bitmap meshes are rebuilt
+        after any unload_font, since their atlas texture may be gone.
+
+@param mesh,      TextMesh to (re)build; start from a default-constructed one
+@param font_path, path to a .ttf file
+@param text,      the string to lay out, any length
+@param size,      height in world units, same as draw_text
+@returns true if the mesh was rebuilt
+*/
+bool build_text_mesh(TextMesh& mesh, const char* font_path, const char* text, float size) {
+    bool sdf = font_mode == FontMode::SDF;
+    if (mesh.vertex_count >= 0 && mesh.size == size &&
+        mesh.font_path == font_path && mesh.text == text && mesh.sdf == sdf &&
+        (sdf ? mesh.sdf_generation == sdf_generation() : mesh.font_generation == font_unloads)) {
+        prof_cache_hit();
+        return false;
+    }
+    prof_cache_miss();
+
+    mesh.font_path = font_path;
+    mesh.text = text;
+    mesh.size = size;
+    mesh.vertices.clear();
+    mesh.vertex_count = 0;
+    mesh.width = 0.0f;
+    mesh.sdf = sdf;
+
+    if (sdf) {
+        mesh.tex = sdf_layout_text(font_path, text, size, mesh.vertices, &mesh.width);
+        mesh.sdf_generation = sdf_generation();
+        if (!mesh.tex) return true;
+    } else {
+        BakedFont* font = load_font(font_path);
+        mesh.tex = font ? font->tex : 0;
+        mesh.font_generation = font_unloads;
+        if (!font) return true;
+
+        // Two triangles per glyph, x/y/u/v per vertex, relative to the baseline origin.
+        float scale = size / BAKE_SIZE;
+        float cx = 0.0f, cy = 0.0f;
+        for (const char* p = text; *p; p++) {
+            if (*p < 32 || *p > 127) continue;
+            stbtt_aligned_quad q;
+            stbtt_GetBakedQuad(font->chars, ATLAS_SIZE, ATLAS_SIZE, *p - 32, &cx, &cy, &q, 1);
+            float x0 = q.x0 * scale, x1 = q.x1 * scale;
+            float y0 = -q.y1 * scale, y1 = -q.y0 * scale;
+            float quad[24] = {
+                x0, y0, q.s0, q.t1,   x1, y0, q.s1, q.t1,   x1, y1, q.s1, q.t0,
+                x0, y0, q.s0, q.t1,   x1, y1, q.s1, q.t0,   x0, y1, q.s0, q.t0,
+            };
+            mesh.vertices.insert(mesh.vertices.end(), quad, quad + 24);
+        }
+        mesh.width = cx * scale;
     }
-    glEnd();
+    mesh.vertex_count = (int)mesh.vertices.size() / 4;
+    prof_count_glyphs(mesh.vertex_count / 6);
+
+    // Keep a VBO when the context has buffer objects; otherwise draw straight
+    // from mesh.vertices.
+    if (!null_backend_active() && gl_load_functions() && mesh.vertex_count > 0) {
+        if (!mesh.vbo) bgl.GenBuffers(1, &mesh.vbo);
+        bgl.BindBuffer(GL_ARRAY_BUFFER, mesh.vbo);
+        bgl.BufferData(GL_ARRAY_BUFFER, mesh.vertices.size() * sizeof(float),
+                       mesh.vertices.data(), GL_STATIC_DRAW);
+        bgl.BindBuffer(GL_ARRAY_BUFFER, 0);
+    }
+    return true;
+}
+
+/*
+@brief, draws a TextMesh with a single draw call.
+
+@param mesh,  TextMesh built by build_text_mesh
+@param x/y,   baseline origin in world coordinates
+@param r/g/b, text color
+*/
+void draw_text_mesh(const TextMesh& mesh, float x, float y, float r, float g, float b) {
+    if (!mesh.tex || mesh.vertex_count <= 0) return;
+    residency_touch(mesh.tex);
+    if (render_queue_recording()) { render_queue_push_text_mesh(&mesh, x, y, r, g, b); return; }
+
+    batch_flush();  // keep queued sprites underneath, as if drawn in call order
+    ProfileScope scope("draw_text_mesh", true);
+    if (null_backend_active()) { gls_count_draw(mesh.vertex_count); return; }
+
+    gls_enable(GL_BLEND);
+    render_apply_blend((int)render_get_blend());
+    gls_bind_texture(mesh.tex);
+    if (core_backend_active()) { core_draw_text_mesh(mesh, x, y, r, g, b); return; }
+
+    gls_enable(GL_TEXTURE_2D);
+    if (mesh.sdf) sdf_shader_begin();
+    else sdf_shader_none();
+    glColor3f(r, g, b);
+    glPushMatrix();
+    glTranslatef(x, y, 0.0f);
+
+    gls_enable_client(GL_VERTEX_ARRAY);
+    gls_enable_client(GL_TEXTURE_COORD_ARRAY);
+    gls_disable_client(GL_COLOR_ARRAY);  // color comes from glColor3f
+    if (mesh.vbo) {
+        bgl.BindBuffer(GL_ARRAY_BUFFER, mesh.vbo);
+        glVertexPointer(2,   GL_FLOAT, 4 * sizeof(float), (const void*)0);
+        glTexCoordPointer(2, GL_FLOAT, 4 * sizeof(float), (const void*)(2 * sizeof(float)));
+    } else {
+        glVertexPointer(2,   GL_FLOAT, 4 * sizeof(float), mesh.vertices.data());
+        glTexCoordPointer(2, GL_FLOAT, 4 * sizeof(float), mesh.vertices.data() + 2);
+    }
+    glDrawArrays(GL_TRIANGLES, 0, mesh.vertex_count);
+    gls_count_draw(mesh.vertex_count);
+    if (mesh.vbo) bgl.BindBuffer(GL_ARRAY_BUFFER, 0);
+    glPopMatrix();
+}
 
-    glDisable(GL_TEXTURE_2D);
-    glDisable(GL_BLEND);
+/* @brief, releases the mesh's GPU buffer. The mesh can be rebuilt afterwards. */
+void free_text_mesh(TextMesh& mesh) {
+    if (mesh.vbo) bgl.DeleteBuffers(1, &mesh.vbo);
+    mesh = TextMesh();
 }
 
 /*
@@ -323,12 +752,14 @@ void draw_text(const char* font_path, const char* text,
 @param text_size, same size value passed to draw_text
 */
 float get_text_cap_height(const char* font_path, float text_size) {
+    if (font_mode == FontMode::SDF) return sdf_cap_height(font_path, text_size);
     BakedFont* font = load_font(font_path);
     if (!font) return text_size;
     return font->pixel_ascender * (text_size / BAKE_SIZE);
 }
 
 float get_text_width(const char* font_path, const char* text, float text_size) {
+    if (font_mode == FontMode::SDF) return sdf_text_width(font_path, text, text_size);
     BakedFont* font = load_font(font_path);
     if (!font) return 0.0f;
     float scale = text_size / BAKE_SIZE;
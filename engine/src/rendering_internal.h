@@ -0,0 +1,87 @@
+// Copyright (c) 2026- b0owl / Brennan Marx-Rennie. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to use,
+// copy, modify, and distribute the Software for NON-COMMERCIAL purposes only,
+// subject to the following conditions:
+//
+// 1. The above copyright notice and this permission notice shall be included
+//    in all copies or substantial portions of the Software.
+// 2. The Software may not be used for commercial purposes without prior
+//    written permission from the copyright holder.
+// 3. Commercial use includes, but is not limited to, selling the Software,
+//    using it in a commercial product, or using it to provide commercial services.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+
+#pragma once
+
+// Internal to the engine: shared between rendering.cpp and assets.cpp so the
+// async loader can decode on worker threads and insert into the same caches.
+
+#include <string>
+#include <vector>
+#include "../vendor/stb_truetype.h"
+#include "../include/rendering.h"
+
+struct SheetEntry { unsigned int tex; int img_w, img_h; TextureOptions options; };
+
+struct BakedFont {
+    unsigned int tex;
+    stbtt_bakedchar chars[96];  // ASCII 32–127
+    float pixel_ascender;       // ascender in pixels at BAKE_SIZE
+};
+
+// CPU-side results. Producing them is thread-safe; uploading is not.
+struct DecodedImage {
+    unsigned char* pixels;  // release with free_decoded_image
+    int img_w, img_h, channels;
+    bool mapped;            // pixels point into a mounted pack, not stb_image memory
+};
+
+struct DecodedFont {
+    std::vector<unsigned char> bitmap;  // 1 channel, ATLAS_SIZE * ATLAS_SIZE
+    stbtt_bakedchar chars[96];
+    float pixel_ascender;
+    const unsigned char* mapped = nullptr;  // the atlas in a mounted pack; bitmap is empty then
+};
+
+// Safe to call from any thread.
+bool decode_image(const char* filepath, DecodedImage& out);
+void free_decoded_image(DecodedImage& image);
+bool bake_font(const char* font_path, DecodedFont& out);
+
+// Lookups are safe from any thread. The cache_* functions upload to the GPU
+// and must run on the GL thread; if the path is already cached they return
+// the existing entry and upload nothing.
+const SheetEntry* find_cached_texture(const std::string& filepath);
+const SheetEntry* cache_texture(const std::string& filepath, const DecodedImage& image,
+                                const TextureOptions& options);
+BakedFont* find_cached_font(const std::string& font_path);
+BakedFont* cache_font(const std::string& font_path, const DecodedFont& font);
+
+// Coverage-only textures (bitmap font atlases, the SDF page). Every draw path
+// samples them as white with alpha = coverage; storage is GL_R8 swizzled on
+// core contexts, luminance-alpha on compatibility ones and RGBA on 3.2 core.
+// Both upload into the bound texture. GL thread only.
+void upload_alpha_texture(int w, int h, const unsigned char* alpha);
+void upload_alpha_subimage(int x, int y, int w, int h, const unsigned char* alpha);
+size_t alpha_texture_bytes(int w, int h);
+
+// Signed distance field text (sdf_text.cpp). GL thread only.
+// Layout emits two triangles per glyph as x, y, u, v, relative to the
+// baseline origin. sdf_generation changes whenever a glyph is evicted from
+// the atlas page, which invalidates previously laid out UVs.
+void sdf_draw_text(const char* font_path, const char* text, float x, float y,
+                   float size, float r, float g, float b);
+unsigned int sdf_layout_text(const char* font_path, const char* text, float size,
+                             std::vector<float>& out_vertices, float* out_width);
+float sdf_text_width(const char* font_path, const char* text, float size);
+float sdf_cap_height(const char* font_path, float size);
+unsigned int sdf_generation();
+// sdf_shader_begin sets up SDF drawing; sdf_shader_none restores plain
+// texture * color drawing for the next draw.
+void sdf_shader_begin();
+void sdf_shader_none();
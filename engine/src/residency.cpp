@@ -0,0 +1,179 @@
+// Copyright (c) 2026- b0owl / Brennan Marx-Rennie. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to use,
+// copy, modify, and distribute the Software for NON-COMMERCIAL purposes only,
+// subject to the following conditions:
+//
+// 1. The above copyright notice and this permission notice shall be included
+//    in all copies or substantial portions of the Software.
+// 2. The Software may not be used for commercial purposes without prior
+//    written permission from the copyright holder.
+// 3. Commercial use includes, but is not limited to, selling the Software,
+//    using it in a commercial product, or using it to provide commercial services.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+
+#ifdef __APPLE__
+  #include <OpenGL/gl.h>
+#else
+  #include <GL/gl.h>
+#endif
+
+#include <stdio.h>
+#include <algorithm>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include "../include/residency.h"
+#include "../include/gl_state.h"
+#include "core_backend.h"
+#include "residency_internal.h"
+
+struct ResidentTexture {
+    std::string path;
+    size_t bytes;
+    ResidencyReload reload;
+    int levels;
+    unsigned int last_used;  // residency frame of the last draw
+    bool resident;
+};
+
+static std::unordered_map<unsigned int, ResidentTexture> residents;
+static std::unordered_map<std::string, int> pins;
+static size_t budget = 0;
+static size_t resident_bytes = 0;
+static int evictions = 0;
+static int reloads = 0;
+static unsigned int frame = 1;
+
+// draw paths touch the same texture many times in a row
+static unsigned int last_touched_tex = 0;
+static unsigned int last_touched_frame = 0;
+
+static bool is_pinned(const std::string& path) {
+    auto it = pins.find(path);
+    return it != pins.end() && it->second > 0;
+}
+
+/* @brief, releases the GPU storage of tex but keeps the name, so handles to it stay valid */
+static void evict(unsigned int tex, ResidentTexture& entry) {
+    if (!null_backend_active()) {
+        static const unsigned char clear_pixel[4] = { 0, 0, 0, 0 };
+        gls_bind_texture(tex);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, clear_pixel);
+        for (int level = 1; level < entry.levels; level++)
+            glTexImage2D(GL_TEXTURE_2D, level, GL_RGBA, 0, 0, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    }
+    entry.resident = false;
+    resident_bytes -= entry.bytes;
+    evictions++;
+}
+
+/* @brief, evicts least recently drawn textures until resident bytes fit the budget */
+static void enforce_budget() {
+    if (budget == 0 || resident_bytes <= budget) return;
+
+    std::vector<std::pair<unsigned int, unsigned int>> candidates;  // last_used, tex
+    for (auto& kv : residents) {
+        const ResidentTexture& entry = kv.second;
+        if (entry.resident && entry.last_used < frame && !is_pinned(entry.path))
+            candidates.push_back({ entry.last_used, kv.first });
+    }
+    std::sort(candidates.begin(), candidates.end());
+
+    for (const auto& candidate : candidates) {
+        if (resident_bytes <= budget) break;
+        evict(candidate.second, residents[candidate.second]);
+    }
+}
+
+void residency_track(unsigned int tex, const std::string& path, size_t bytes, ResidencyReload reload,
+                     int levels) {
+    if (!tex) return;
+    residency_untrack(tex);
+    residents[tex] = ResidentTexture{ path, bytes, reload, levels, frame, true };
+    resident_bytes += bytes;
+    enforce_budget();
+}
+
+void residency_untrack(unsigned int tex) {
+    auto it = residents.find(tex);
+    if (it == residents.end()) return;
+    if (it->second.resident) resident_bytes -= it->second.bytes;
+    residents.erase(it);
+    if (last_touched_tex == tex) last_touched_tex = 0;
+}
+
+void residency_touch(unsigned int tex) {
+    if (tex == last_touched_tex && frame == last_touched_frame) return;
+    last_touched_tex = tex;
+    last_touched_frame = frame;
+
+    auto it = residents.find(tex);
+    if (it == residents.end()) return;
+    ResidentTexture& entry = it->second;
+    entry.last_used = frame;
+    if (entry.resident) return;
+
+    if (!entry.reload(entry.path, tex)) {
+        fprintf(stderr, "[bytee] can't reload evicted texture %s\n", entry.path.c_str());
+        return;
+    }
+    entry.resident = true;
+    resident_bytes += entry.bytes;
+    reloads++;
+    enforce_budget();
+}
+
+void residency_end_frame() {
+    frame++;
+    enforce_budget();
+}
+
+/*
+@brief, sets the texture memory budget. Takes effect at the next upload or
+        the end of the frame.
+
+@param bytes, budget in bytes; 0 disables eviction
+*/
+void residency_set_budget(size_t bytes) {
+    budget = bytes;
+}
+
+size_t residency_get_budget() {
+    return budget;
+}
+
+/* @brief, estimated bytes of tracked textures currently on the GPU */
+size_t residency_resident_bytes() {
+    return resident_bytes;
+}
+
+ResidencyStats residency_stats() {
+    ResidencyStats stats = { budget, resident_bytes, 0, 0, 0, evictions, reloads };
+    for (const auto& kv : residents) {
+        if (kv.second.resident) stats.resident++;
+        else { stats.evicted++; stats.evicted_bytes += kv.second.bytes; }
+    }
+    return stats;
+}
+
+/* @brief, keeps path resident until a matching residency_unpin; reloads it now if it was evicted */
+void residency_pin(const char* path) {
+    pins[path]++;
+    for (auto& kv : residents) {
+        if (kv.second.path == path && !kv.second.resident) {
+            last_touched_tex = 0;
+            residency_touch(kv.first);
+        }
+    }
+}
+
+void residency_unpin(const char* path) {
+    auto it = pins.find(path);
+    if (it == pins.end()) return;
+    if (--it->second <= 0) pins.erase(it);
+}
@@ -0,0 +1,38 @@
+// Copyright (c) 2026- b0owl / Brennan Marx-Rennie. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to use,
+// copy, modify, and distribute the Software for NON-COMMERCIAL purposes only,
+// subject to the following conditions:
+//
+// 1. The above copyright notice and this permission notice shall be included
+//    in all copies or substantial portions of the Software.
+// 2. The Software may not be used for commercial purposes without prior
+//    written permission from the copyright holder.
+// 3. Commercial use includes, but is not limited to, selling the Software,
+//    using it in a commercial product, or using it to provide commercial services.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+
+#pragma once
+
+// Internal to the engine: how the texture caches in rendering.cpp report to
+// the residency manager. GL thread only.
+
+#include <stddef.h>
+#include <string>
+
+// Re-uploads path into the existing texture name tex. Returns false if the
+// file can't be loaded anymore.
+typedef bool (*ResidencyReload)(const std::string& path, unsigned int tex);
+
+// levels is the number of mip levels tex was uploaded with; eviction frees them all.
+void residency_track(unsigned int tex, const std::string& path, size_t bytes, ResidencyReload reload,
+                     int levels = 1);
+void residency_untrack(unsigned int tex);
+// Marks tex as used this frame, reloading it first if it was evicted.
+// Untracked textures are ignored.
+void residency_touch(unsigned int tex);
+void residency_end_frame();
@@ -9,4 +9,6 @@ struct Scene {
     // Returns the next scene to transition to, or SceneID::None to stay
     virtual SceneID tick(GLFWwindow* window, float delta_time,
                          float cur_aspect, int fb_w, int fb_h) = 0;
+    // Called for every fixed simulation step when driven by run_loop
+    virtual void fixed_update(double dt) { (void)dt; }
 };
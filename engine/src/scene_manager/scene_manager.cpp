@@ -8,4 +8,8 @@ SceneID SceneManager::tick(GLFWwindow* window, float delta_time,
                             float cur_aspect, int fb_w, int fb_h) {
     if (!m_scene) return SceneID::None;
     return m_scene->tick(window, delta_time, cur_aspect, fb_w, fb_h);
+}
+
+void SceneManager::fixed_update(double dt) {
+    if (m_scene) m_scene->fixed_update(dt);
 }
\ No newline at end of file
@@ -8,6 +8,7 @@ public:
     void set(std::unique_ptr<Scene> scene);
     SceneID tick(GLFWwindow* window, float delta_time,
                  float cur_aspect, int fb_w, int fb_h);
+    void fixed_update(double dt);
 private:
     std::unique_ptr<Scene> m_scene;
 };
\ No newline at end of file
@@ -0,0 +1,361 @@
+// Copyright (c) 2026- b0owl / Brennan Marx-Rennie. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to use,
+// copy, modify, and distribute the Software for NON-COMMERCIAL purposes only,
+// subject to the following conditions:
+//
+// 1. The above copyright notice and this permission notice shall be included
+//    in all copies or substantial portions of the Software.
+// 2. The Software may not be used for commercial purposes without prior
+//    written permission from the copyright holder.
+// 3. Commercial use includes, but is not limited to, selling the Software,
+//    using it in a commercial product, or using it to provide commercial services.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+
+#include <stdio.h>
+#include <string.h>
+#include <memory>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include "../include/batch.h"
+#include "../include/gl_state.h"
+#include "../include/render_queue.h"
+#include "../include/profiler.h"
+#include "core_backend.h"
+#include "gl_functions.h"
+#include "rendering_internal.h"
+#include "profiler_internal.h"
+
+// Signed distance field text
+// Glyphs are rasterized on first use with stbtt_GetCodepointSDF at SDF_SIZE
+// and stored in fixed-size cells of one shared atlas page. Since the page
+// holds distances rather than coverage, the same cell is crisp at any draw
+// size. When every cell is taken, the least recently used glyph is evicted.
+
+static const int   SDF_PAGE_SIZE = 1024;
+static const int   SDF_CELL      = 64;     // cell edge in px, fits a padded SDF_SIZE glyph
+static const float SDF_SIZE      = 40.0f;  // glyphs are rasterized at this px height
+static const int   SDF_PADDING   = 6;      // px of distance field around each glyph
+static const int   SDF_CELLS_PER_ROW = SDF_PAGE_SIZE / SDF_CELL;
+static const int   SDF_CELL_COUNT    = SDF_CELLS_PER_ROW * SDF_CELLS_PER_ROW;
+
+struct SdfGlyph {
+    int cell;        // atlas cell, -1 if evicted or the glyph has no pixels
+    int w, h;        // bitmap size in px, 0 for blank glyphs (space)
+    int xoff, yoff;  // bitmap offset from the pen position, y down
+    float advance;   // px at SDF_SIZE
+};
+
+struct SdfFont {
+    std::vector<unsigned char> data;  // stbtt_fontinfo points into this
+    stbtt_fontinfo info;
+    float scale;                      // font units -> px at SDF_SIZE
+    float pixel_ascender;
+    std::unordered_map<int, SdfGlyph> glyphs;  // metrics stay after eviction
+};
+
+struct SdfCell {
+    SdfFont* font;   // owner, nullptr if free
+    int codepoint;
+    unsigned long long last_used;
+};
+
+static unsigned int sdf_tex = 0;
+static std::vector<SdfCell> sdf_cells;
+static int sdf_cells_used = 0;
+static unsigned long long sdf_tick = 0;
+static unsigned int sdf_evictions = 0;
+static std::unordered_map<std::string, std::unique_ptr<SdfFont>> sdf_fonts;
+
+static GLuint sdf_program = 0;
+static bool   sdf_program_failed = false;
+
+static const char* SDF_VS =
+    "#version 120\n"
+    "varying vec2 v_uv;\n"
+    "varying vec4 v_color;\n"
+    "void main() {\n"
+    "    v_uv = gl_MultiTexCoord0.xy;\n"
+    "    v_color = gl_Color;\n"
+    "    gl_Position = gl_ModelViewProjectionMatrix * gl_Vertex;\n"
+    "}\n";
+
+// The edge sits at 0.5; fwidth keeps the antialiased band one screen pixel
+// wide whether the glyph is drawn tiny or huge.
+static const char* SDF_FS =
+    "#version 120\n"
+    "uniform sampler2D u_tex;\n"
+    "varying vec2 v_uv;\n"
+    "varying vec4 v_color;\n"
+    "void main() {\n"
+    "    float d = texture2D(u_tex, v_uv).a;\n"
+    "    float w = max(fwidth(d), 0.0001);\n"
+    "    float a = smoothstep(0.5 - w, 0.5 + w, d);\n"
+    "    gl_FragColor = vec4(v_color.rgb, v_color.a * a);\n"
+    "}\n";
+
+/* @brief, decodes one UTF-8 sequence and advances p. Malformed input yields U+FFFD. */
+static int utf8_next(const char*& p) {
+    const unsigned char* s = (const unsigned char*)p;
+    int cp, extra;
+    if      (s[0] < 0x80)           { cp = s[0];        extra = 0; }
+    else if ((s[0] & 0xE0) == 0xC0) { cp = s[0] & 0x1F; extra = 1; }
+    else if ((s[0] & 0xF0) == 0xE0) { cp = s[0] & 0x0F; extra = 2; }
+    else if ((s[0] & 0xF8) == 0xF0) { cp = s[0] & 0x07; extra = 3; }
+    else { p++; return 0xFFFD; }
+
+    for (int i = 1; i <= extra; i++) {
+        if ((s[i] & 0xC0) != 0x80) { p += i; return 0xFFFD; }
+        cp = (cp << 6) | (s[i] & 0x3F);
+    }
+    p += extra + 1;
+    return cp;
+}
+
+/*
+@brief, loads and caches a font for SDF rendering. A path that fails to load
+        is cached as nullptr, so it is reported once rather than reopened
+        every frame.
+*/
+static SdfFont* load_sdf_font(const char* font_path) {
+    auto it = sdf_fonts.find(font_path);
+    if (it != sdf_fonts.end()) { prof_cache_hit(); return it->second.get(); }
+    prof_cache_miss();
+    sdf_fonts[font_path] = nullptr;
+
+    FILE* f = fopen(font_path, "rb");
+    if (!f) { fprintf(stderr, "[bytee] failed to open font %s\n", font_path); return nullptr; }
+    fseek(f, 0, SEEK_END);
+    long fsize = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    if (fsize <= 0) {
+        fclose(f);
+        fprintf(stderr, "[bytee] failed to read font %s\n", font_path);
+        return nullptr;
+    }
+
+    std::unique_ptr<SdfFont> font(new SdfFont());
+    font->data.resize(fsize);
+    size_t read = fread(font->data.data(), 1, fsize, f);
+    fclose(f);
+    if (read != (size_t)fsize) {
+        fprintf(stderr, "[bytee] failed to read font %s\n", font_path);
+        return nullptr;
+    }
+
+    if (!stbtt_InitFont(&font->info, font->data.data(), 0)) {
+        fprintf(stderr, "[bytee] failed to parse font %s\n", font_path);
+        return nullptr;
+    }
+    int asc, desc, gap;
+    stbtt_GetFontVMetrics(&font->info, &asc, &desc, &gap);
+    font->scale = stbtt_ScaleForPixelHeight(&font->info, SDF_SIZE);
+    font->pixel_ascender = asc * font->scale;
+
+    SdfFont* raw = font.get();
+    sdf_fonts[font_path] = std::move(font);
+    return raw;
+}
+
+static void create_sdf_page() {
+    sdf_cells.assign(SDF_CELL_COUNT, SdfCell{ nullptr, 0, 0 });
+    sdf_tex = gls_gen_texture();
+    if (null_backend_active()) return;
+    std::vector<unsigned char> blank(SDF_PAGE_SIZE * SDF_PAGE_SIZE, 0);
+    gls_bind_texture(sdf_tex);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    upload_alpha_texture(SDF_PAGE_SIZE, SDF_PAGE_SIZE, blank.data());
+}
+
+/* @brief, returns a free cell, evicting the least recently used glyph if the page is full */
+static int acquire_cell(SdfFont* font, int codepoint) {
+    int cell = -1;
+    if (sdf_cells_used < SDF_CELL_COUNT) {
+        cell = sdf_cells_used++;
+    } else {
+        cell = 0;
+        for (int i = 1; i < SDF_CELL_COUNT; i++) {
+            if (sdf_cells[i].last_used < sdf_cells[cell].last_used) cell = i;
+        }
+        // Queued quads may still point at the victim's cell.
+        render_queue_flush();
+        SdfCell& victim = sdf_cells[cell];
+        victim.font->glyphs[victim.codepoint].cell = -1;
+        sdf_evictions++;
+    }
+    sdf_cells[cell] = SdfCell{ font, codepoint, sdf_tick };
+    return cell;
+}
+
+/* @brief, uploads a one channel distance field into a cell; the rest of the cell is cleared */
+static void upload_cell(int cell, const unsigned char* sdf, int w, int h) {
+    if (null_backend_active()) return;
+    static unsigned char pixels[SDF_CELL * SDF_CELL];
+    memset(pixels, 0, sizeof(pixels));
+    for (int y = 0; y < h; y++) memcpy(&pixels[y * SDF_CELL], &sdf[y * w], w);
+    gls_bind_texture(sdf_tex);
+    upload_alpha_subimage((cell % SDF_CELLS_PER_ROW) * SDF_CELL, (cell / SDF_CELLS_PER_ROW) * SDF_CELL,
+                          SDF_CELL, SDF_CELL, pixels);
+}
+
+/* @brief, returns the glyph for codepoint, rasterizing it into the atlas if it is not resident */
+static const SdfGlyph& get_glyph(SdfFont* font, int codepoint) {
+    sdf_tick++;
+    auto it = font->glyphs.find(codepoint);
+    if (it != font->glyphs.end()) {
+        SdfGlyph& glyph = it->second;
+        if (glyph.cell >= 0) { sdf_cells[glyph.cell].last_used = sdf_tick; prof_cache_hit(); return glyph; }
+        if (glyph.w == 0) { prof_cache_hit(); return glyph; }
+    }
+    prof_cache_miss();
+    PROFILE_SCOPE("sdf_rasterize");
+
+    if (!sdf_tex) create_sdf_page();
+
+    int advance, lsb;
+    stbtt_GetCodepointHMetrics(&font->info, codepoint, &advance, &lsb);
+    SdfGlyph glyph = { -1, 0, 0, 0, 0, advance * font->scale };
+
+    int w = 0, h = 0, xoff = 0, yoff = 0;
+    unsigned char* sdf = stbtt_GetCodepointSDF(&font->info, font->scale, codepoint,
+                                               SDF_PADDING, 128, 128.0f / SDF_PADDING,
+                                               &w, &h, &xoff, &yoff);
+    if (sdf) {
+        // Glyphs wider than a cell at SDF_SIZE are rare; they advance but don't draw.
+        if (w <= SDF_CELL && h <= SDF_CELL) {
+            glyph.cell = acquire_cell(font, codepoint);
+            glyph.w = w; glyph.h = h;
+            glyph.xoff = xoff; glyph.yoff = yoff;
+            upload_cell(glyph.cell, sdf, w, h);
+        }
+        stbtt_FreeSDF(sdf, nullptr);
+    }
+
+    SdfGlyph& stored = font->glyphs[codepoint];
+    stored = glyph;
+    return stored;
+}
+
+// Walks text, calling emit(glyph, pen_x) in px at SDF_SIZE for every codepoint.
+// Returns the total advance in px.
+template <typename Emit>
+static float walk_text(SdfFont* font, const char* text, bool rasterize, Emit emit) {
+    float pen = 0.0f;
+    int prev = 0;
+    for (const char* p = text; *p; ) {
+        int cp = utf8_next(p);
+        if (cp < 32) { prev = 0; continue; }
+        if (prev) pen += stbtt_GetCodepointKernAdvance(&font->info, prev, cp) * font->scale;
+        if (rasterize) {
+            const SdfGlyph& glyph = get_glyph(font, cp);
+            emit(glyph, pen);
+            pen += glyph.advance;
+        } else {
+            int advance, lsb;
+            stbtt_GetCodepointHMetrics(&font->info, cp, &advance, &lsb);
+            pen += advance * font->scale;
+        }
+        prev = cp;
+    }
+    return pen;
+}
+
+static void cell_uvs(const SdfGlyph& glyph, float& u0, float& v0, float& u1, float& v1) {
+    const float texel = 1.0f / SDF_PAGE_SIZE;
+    u0 = (glyph.cell % SDF_CELLS_PER_ROW) * SDF_CELL * texel;
+    v0 = (glyph.cell / SDF_CELLS_PER_ROW) * SDF_CELL * texel;
+    u1 = u0 + glyph.w * texel;
+    v1 = v0 + glyph.h * texel;
+}
+
+void sdf_draw_text(const char* font_path, const char* text, float x, float y,
+                   float size, float r, float g, float b) {
+    SdfFont* font = load_sdf_font(font_path);
+    if (!font) return;
+
+    float scale = size / SDF_SIZE;
+    int glyphs = 0;
+    walk_text(font, text, true, [&](const SdfGlyph& glyph, float pen) {
+        if (glyph.cell < 0) return;
+        glyphs++;
+        float u0, v0, u1, v1;
+        cell_uvs(glyph, u0, v0, u1, v1);
+        // v0 is the top row of the bitmap; world y points up.
+        float x0 = x + (pen + glyph.xoff) * scale;
+        float y1 = y - glyph.yoff * scale;
+        batch_submit(sdf_tex, x0, y1 - glyph.h * scale, x0 + glyph.w * scale, y1,
+                     u0, v1, u1, v0, r, g, b, 1.0f, BATCH_SHADER_SDF);
+    });
+    prof_count_glyphs(glyphs);
+}
+
+unsigned int sdf_layout_text(const char* font_path, const char* text, float size,
+                             std::vector<float>& out_vertices, float* out_width) {
+    SdfFont* font = load_sdf_font(font_path);
+    if (!font) return 0;
+
+    float scale = size / SDF_SIZE;
+    float width = walk_text(font, text, true, [&](const SdfGlyph& glyph, float pen) {
+        if (glyph.cell < 0) return;
+        float u0, v0, u1, v1;
+        cell_uvs(glyph, u0, v0, u1, v1);
+        float x0 = (pen + glyph.xoff) * scale, x1 = x0 + glyph.w * scale;
+        float y1 = -glyph.yoff * scale,         y0 = y1 - glyph.h * scale;
+        float quad[24] = {
+            x0, y0, u0, v1,   x1, y0, u1, v1,   x1, y1, u1, v0,
+            x0, y0, u0, v1,   x1, y1, u1, v0,   x0, y1, u0, v0,
+        };
+        out_vertices.insert(out_vertices.end(), quad, quad + 24);
+    });
+    if (out_width) *out_width = width * scale;
+    return sdf_tex;
+}
+
+float sdf_text_width(const char* font_path, const char* text, float size) {
+    SdfFont* font = load_sdf_font(font_path);
+    if (!font) return 0.0f;
+    return walk_text(font, text, false, [](const SdfGlyph&, float) {}) * (size / SDF_SIZE);
+}
+
+float sdf_cap_height(const char* font_path, float size) {
+    SdfFont* font = load_sdf_font(font_path);
+    if (!font) return size;
+    return font->pixel_ascender * (size / SDF_SIZE);
+}
+
+unsigned int sdf_generation() {
+    return sdf_evictions;
+}
+
+/*
+@brief, binds the SDF program for the following draws. Without shader support
+        the edge is cut with the alpha test instead — still scalable, but
+        aliased.
+*/
+void sdf_shader_begin() {
+    if (!sdf_program && !sdf_program_failed) {
+        if (gl_load_functions()) sdf_program = gl_build_program(SDF_VS, SDF_FS, nullptr, 0);
+        if (sdf_program) {
+            gls_use_program(sdf_program);
+            bgl.Uniform1i(bgl.GetUniformLocation(sdf_program, "u_tex"), 0);
+        } else {
+            sdf_program_failed = true;
+            glAlphaFunc(GL_GEQUAL, 0.5f);  // nothing else in the engine touches the alpha func
+        }
+    }
+    if (sdf_program) gls_use_program(sdf_program);
+    else gls_enable(GL_ALPHA_TEST);
+}
+
+void sdf_shader_none() {
+    gls_use_program(0);
+    gls_disable(GL_ALPHA_TEST);
+}
@@ -27,7 +27,18 @@
 #include "../include/window.h"
 #include "../include/mouse.h"
 #include "../include/rendering.h"
-
+#include "../include/batch.h"
+#include "../include/assets.h"
+#include "../include/gl_state.h"
+#include "../include/render_queue.h"
+#include "../include/profiler.h"
+#include "../include/collisions.h"
+#include "core_backend.h"
+#include "residency_internal.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
 #include <string>
 #include <unordered_map>
@@ -39,15 +50,52 @@
 #endif
 
 static bool initilized = false;
+static HeadlessMode headless_mode = HeadlessMode::Off;
+
+/*
+@brief, applies BYTEE_HEADLESS ("offscreen" or "null") over the mode set in
+        code. Unset, empty or "0" leave it alone; anything else is ignored
+        with a warning rather than guessed at.
+*/
+static void read_headless_env() {
+    const char* env = getenv("BYTEE_HEADLESS");
+    if (!env || !*env || strcmp(env, "0") == 0) return;
+    if (strcmp(env, "null") == 0) headless_mode = HeadlessMode::Null;
+    else if (strcmp(env, "offscreen") == 0) headless_mode = HeadlessMode::Offscreen;
+    else {
+        static bool warned = false;
+        if (!warned) fprintf(stderr, "[bytee] ignoring BYTEE_HEADLESS=%s, expected offscreen or null\n", env);
+        warned = true;
+    }
+}
+
+/* @brief, glfwInit, selecting GLFW's null platform first when running headless */
+static bool init_glfw() {
+    read_headless_env();
+    if (headless_mode != HeadlessMode::Off) {
+#ifdef GLFW_PLATFORM_NULL
+        glfwInitHint(GLFW_PLATFORM, GLFW_PLATFORM_NULL);
+#else
+        static bool warned = false;
+        if (!warned) fprintf(stderr, "[bytee] headless mode needs GLFW 3.4+, opening a normal window\n");
+        warned = true;
+#endif
+    }
+    return glfwInit() == GLFW_TRUE;
+}
 
 /* This function exists solely for readability, as glfwInit() + non glfw calls in the same
 file may be confusing to some. Initializing through this function is NOT required but
 recommended under most circumstances. */
 void init_bytee() {
-    glfwInit();
+    init_glfw();
     initilized = true;
 }
 
+/* @brief, selects headless mode; call before init_bytee / create_window */
+void set_headless_mode(HeadlessMode mode) { headless_mode = mode; }
+HeadlessMode get_headless_mode()          { return headless_mode; }
+
 // DEFAULT CONFIGS ------------------------
 
 /*
@@ -63,12 +111,10 @@ float setup_2d_orthographic(GLFWwindow *window, std::array<float, 4> clrcolor) {
     int w, h;
     glfwGetFramebufferSize(window, &w, &h);
     float aspect = (float)w / (float)h;
+    render_queue_flush();  // pending draws belong to the old projection
+    backend_set_ortho(-aspect, aspect, -1, 1);
+    if (null_backend_active()) return aspect;
     glViewport(0, 0, w, h);
-    glMatrixMode(GL_PROJECTION);
-    glLoadIdentity();
-    glOrtho(-aspect, aspect, -1, 1, -1, 1);
-    glMatrixMode(GL_MODELVIEW);
-    glLoadIdentity();
     glClearColor(clrcolor[0], clrcolor[1], clrcolor[2], clrcolor[3]);
     return aspect;
 }
@@ -112,13 +158,26 @@ void enable_msaa_4x()                              { glfwWindowHint(GLFW_SAMPLES
 void enable_msaa_8x()                              { glfwWindowHint(GLFW_SAMPLES, 8);             }
 void enable_double_buffering()                     { glfwWindowHint(GLFW_DOUBLEBUFFER, GLFW_TRUE);}
 void set_refresh_rate(int refresh)                 { glfwWindowHint(GLFW_REFRESH_RATE, refresh);  }
-void set_clear_color(float R, float G, float B, float A) { glClearColor(R, G, B, A);              }
+void set_clear_color(float R, float G, float B, float A) {
+    if (!null_backend_active()) glClearColor(R, G, B, A);
+}
 
 /* @brief, housekeeping that runs at the end of your mainloop */
 void glCleanup(GLFWwindow *window) {
-    glfwSwapBuffers(window);
+    render_queue_flush();  // sorts and draws queued commands, then flushes the batch
+    frame_allocator_default().end_frame();  // after the flush, which may read its objects
+    residency_end_frame(); // evicts over-budget textures nothing drew this frame
+    gls_reset_defaults();  // raw GL in the next frame starts from a clean slate
+    gls_end_frame();
+    bool null = null_backend_active();
+    if (!null) {
+        PROFILE_SCOPE("swap_buffers");
+        glfwSwapBuffers(window);
+    }
     glfwPollEvents();
-    glClear(GL_COLOR_BUFFER_BIT);
+    process_asset_uploads();
+    profiler_end_frame();
+    if (!null) glClear(GL_COLOR_BUFFER_BIT);
 }
 
 /*
@@ -136,12 +195,9 @@ void update_viewport(GLFWwindow* window, int* fb_w, int* fb_h, float* aspect) {
     glfwGetFramebufferSize(window, fb_w, fb_h);
     if (*fb_w == 0 || *fb_h == 0) return;
     *aspect = (float)(*fb_w) / (float)(*fb_h);
-    glViewport(0, 0, *fb_w, *fb_h);
-    glMatrixMode(GL_PROJECTION);
-    glLoadIdentity();
-    glOrtho(-(*aspect), *aspect, -1, 1, -1, 1);
-    glMatrixMode(GL_MODELVIEW);
-    glLoadIdentity();
+    render_queue_flush();  // pending draws belong to the old projection
+    if (!null_backend_active()) glViewport(0, 0, *fb_w, *fb_h);
+    backend_set_ortho(-(*aspect), *aspect, -1, 1);
 }
 
 /*
@@ -158,9 +214,44 @@ float compute_delta_time(float* last_time) {
     return dt;
 }
 
+/* @brief, compute_delta_time on double-precision timestamps; initialize *last_time = 0.0 */
+double compute_delta_time(double* last_time) {
+    double current = glfwGetTime();
+    double dt = current - *last_time;
+    *last_time = current;
+    return dt;
+}
+
+/*
+@brief, headless window on GLFW's null platform. Offscreen asks for an OSMesa
+        context; if that isn't available, or in Null mode, the window has no
+        context and the null renderer is used instead.
+*/
+static GLFWwindow* create_headless_window(int x_dim, int y_dim, const char* title_bar) {
+    glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+    if (headless_mode == HeadlessMode::Offscreen) {
+        glfwWindowHint(GLFW_CONTEXT_CREATION_API, GLFW_OSMESA_CONTEXT_API);
+        GLFWwindow* window = glfwCreateWindow(x_dim, y_dim, title_bar, nullptr, nullptr);
+        if (window) { glfwMakeContextCurrent(window); return window; }
+        fprintf(stderr, "[bytee] no offscreen GL context available, using the null renderer\n");
+    }
+    glfwWindowHint(GLFW_CLIENT_API, GLFW_NO_API);
+    GLFWwindow* window = glfwCreateWindow(x_dim, y_dim, title_bar, nullptr, nullptr);
+    if (window) backend_use_null();
+    return window;
+}
+
 /* Creates a new window */
 GLFWwindow* create_window(int x_dim, int y_dim, const char* title_bar) {
-    if (!glfwInit()) return nullptr; 
+    if (!init_glfw()) return nullptr;
+
+#ifdef GLFW_PLATFORM_NULL
+    if (headless_mode != HeadlessMode::Off) {
+        GLFWwindow* window = create_headless_window(x_dim, y_dim, title_bar);
+        if (!window) glfwTerminate();
+        return window;
+    }
+#endif
 
     GLFWwindow* window = glfwCreateWindow(x_dim, y_dim, title_bar, nullptr, nullptr);
     if (!window) { glfwTerminate(); return nullptr; }
@@ -171,7 +262,29 @@ GLFWwindow* create_window(int x_dim, int y_dim, const char* title_bar) {
 
 // WIDGET AREAS ------------------------
 
-static std::unordered_map<std::string, WidgetArea> widget_tracker;
+struct TrackedWidget {
+    WidgetArea area;
+    int proxy;            // in widget_tree
+    unsigned int order;   // when it was last defined; later ones are on top
+};
+
+static std::unordered_map<std::string, TrackedWidget> widget_tracker;
+// The same areas, for widget_at. Proxy user pointers are widget_tracker
+// elements, which don't move while the map grows.
+static AabbTree widget_tree(0.0f);
+static unsigned int widget_clock = 0;
+
+static WidgetArea track_widget(const char* ID, WidgetArea area) {
+    auto it = widget_tracker.find(ID);
+    if (it == widget_tracker.end()) it = widget_tracker.emplace(ID, TrackedWidget{ area, -1, 0 }).first;
+    TrackedWidget& widget = it->second;
+    widget.area = area;
+    widget.order = ++widget_clock;
+    float width = area.x2 - area.x1, height = area.y2 - area.y1;
+    if (widget.proxy < 0) widget.proxy = widget_tree.add_box(area.x1, area.y1, width, height, &*it);
+    else widget_tree.move_box(widget.proxy, area.x1, area.y1, width, height);
+    return area;
+}
 
 /*
 @brief, registers a widget area for a given ID and returns its span.
@@ -182,9 +295,7 @@ static std::unordered_map<std::string, WidgetArea> widget_tracker;
 @returns the registered WidgetArea
 */
 WidgetArea define_widget_area(const char* ID, float x1, float x2, float y1, float y2) {
-    WidgetArea area = { x1, x2, y1, y2 };
-    widget_tracker[ID] = area;
-    return area;
+    return track_widget(ID, { x1, x2, y1, y2 });
 }
 
 /*
@@ -196,7 +307,7 @@ WidgetArea define_widget_area(const char* ID, float x1, float x2, float y1, floa
 */
 WidgetArea get_widget_area(const char* ID) {
     auto it = widget_tracker.find(ID);
-    if (it != widget_tracker.end()) return it->second;
+    if (it != widget_tracker.end()) return it->second.area;
     return { -2.0f, -2.0f, -2.0f, -2.0f };
 }
 
@@ -210,14 +321,20 @@ WidgetArea get_widget_area(const char* ID) {
 
 @return, true if mouse is hovering on a given widget, otherwise return will be false
 */
-bool check_widget_hover(GLFWwindow* window, const char* ID, int fb_w, int fb_h, float cur_aspect) {
-    WidgetArea wa = get_widget_area(ID);
+static void mouse_world_position(GLFWwindow* window, int fb_w, int fb_h, float cur_aspect,
+                                 float& world_x, float& world_y) {
     MouseState ms;
     get_mouse_state(window, ms);
     float gl_x, gl_y;
     screen_to_gl(ms.x, ms.y, fb_w, fb_h, gl_x, gl_y);
-    float world_x = gl_x * cur_aspect;
-    float world_y = gl_y;
+    world_x = gl_x * cur_aspect;
+    world_y = gl_y;
+}
+
+bool check_widget_hover(GLFWwindow* window, const char* ID, int fb_w, int fb_h, float cur_aspect) {
+    WidgetArea wa = get_widget_area(ID);
+    float world_x, world_y;
+    mouse_world_position(window, fb_w, fb_h, cur_aspect, world_x, world_y);
     return world_x >= wa.x1 && world_x <= wa.x2 &&
            world_y >= wa.y1 && world_y <= wa.y2;
 }
@@ -284,7 +401,31 @@ WidgetInfoArea optimal_widget_info_area(const char* ID, int fb_w, int fb_h, floa
 WidgetArea define_text_area(const char* ID, const char* font_path, const char* text, float x, float y, float size) {
     float cap_height = get_text_cap_height(font_path, size);
     float text_width = get_text_width(font_path, text, size);
-    WidgetArea area = { x, x + text_width, y, y + cap_height };
-    widget_tracker[ID] = area;
-    return area;
+    return track_widget(ID, { x, x + text_width, y, y + cap_height });
+}
+
+/*
+@brief, finds the widget area under a point without checking every ID.
+        If several overlap, the most recently defined one wins, which is
+        the one drawn on top when areas are defined in draw order.
+
+@param world_x/world_y, the point in world coordinates
+@returns the widget's ID, or nullptr if there is none
+*/
+const char* widget_at(float world_x, float world_y) {
+    static std::vector<int> hits;
+    const std::pair<const std::string, TrackedWidget>* top = nullptr;
+    widget_tree.query_point(world_x, world_y, hits);
+    for (int proxy : hits) {
+        auto* widget = (const std::pair<const std::string, TrackedWidget>*)widget_tree.user(proxy);
+        if (!top || widget->second.order > top->second.order) top = widget;
+    }
+    return top ? top->first.c_str() : nullptr;
+}
+
+/* @brief, widget_at for the mouse position; same params as check_widget_hover */
+const char* widget_under_mouse(GLFWwindow* window, int fb_w, int fb_h, float cur_aspect) {
+    float world_x, world_y;
+    mouse_world_position(window, fb_w, fb_h, cur_aspect, world_x, world_y);
+    return widget_at(world_x, world_y);
 }
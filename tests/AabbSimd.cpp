@@ -0,0 +1,80 @@
+// Copyright (c) 2026- b0owl / Brennan Marx-Rennie. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to use,
+// copy, modify, and distribute the Software for NON-COMMERCIAL purposes only,
+// subject to the following conditions:
+//
+// 1. The above copyright notice and this permission notice shall be included
+//    in all copies or substantial portions of the Software.
+// 2. The Software may not be used for commercial purposes without prior
+//    written permission from the copyright holder.
+// 3. Commercial use includes, but is not limited to, selling the Software,
+//    using it in a commercial product, or using it to provide commercial services.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+
+
+#include "../engine/include/collisions.h"
+#include <iostream>
+#include <vector>
+
+#define GREEN "\033[1;32m"
+#define RED   "\033[1;31m"
+#define RESET "\033[0m"
+
+int main() {
+    // 70 boxes in a row, 10 apart and 5 wide, so the masks span three words
+    // and the last one is partial.
+    std::vector<DrawData> objects(70);
+    std::vector<void*> ptr(70);
+    for (int i = 0; i < 70; i++) {
+        objects[i] = DrawData{};
+        objects[i].x = i * 10.0f;
+        objects[i].width = 5.0f;
+        objects[i].height = 5.0f;
+        ptr[i] = &objects[i];
+    }
+    ptr[41] = nullptr;
+
+    BoxSoA boxes;
+    aabb_from_objects(ptr.data(), 70, boxes);
+    int words = aabb_mask_words(70);
+
+    /* Test #1; one box against many, boxes 39..42 minus the null */
+    std::vector<uint32_t> mask(words);
+    int hits = aabb_overlap_mask(395.0f, 0.0f, 420.0f, 1.0f, boxes, mask.data());
+    if (hits == 3 && mask[0] == 0 && mask[1] == ((1u << 7) | (1u << 8) | (1u << 10)) && mask[2] == 0)
+        std::cout << GREEN "   Test 1 Passed!" RESET << std::endl;
+    else std::cout << RED " 󰍹  Test 1 Failed!" RESET << std::endl;
+
+    /* Test #2; every path writes the same bits */
+    BoxSoA queries;
+    aabb_from_objects(ptr.data(), 70, queries);
+    std::vector<uint32_t> expected(70 * words), got(70 * words);
+    aabb_set_simd(AabbSimd::Scalar);
+    aabb_overlap_masks(queries, boxes, expected.data());
+    bool same = true;
+    for (AabbSimd path : { AabbSimd::SSE2, AabbSimd::AVX2 }) {
+        aabb_set_simd(path);
+        aabb_overlap_masks(queries, boxes, got.data());
+        same = same && got == expected;
+    }
+    if (same) std::cout << GREEN "   Test 2 Passed!" RESET << std::endl;
+    else std::cout << RED " 󰍹  Test 2 Failed!" RESET << std::endl;
+
+    /* Test #3; each box only overlaps itself, the null row is empty */
+    bool diagonal = true;
+    for (int i = 0; i < 70; i++) {
+        for (int w = 0; w < words; w++) {
+            uint32_t want = (i != 41 && i / 32 == w) ? 1u << (i % 32) : 0u;
+            diagonal = diagonal && expected[i * words + w] == want;
+        }
+    }
+    if (diagonal) std::cout << GREEN "   Test 3 Passed!" RESET << std::endl;
+    else std::cout << RED " 󰍹  Test 3 Failed!" RESET << std::endl;
+
+    return 0;
+}
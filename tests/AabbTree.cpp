@@ -0,0 +1,61 @@
+// Copyright (c) 2026- b0owl / Brennan Marx-Rennie. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to use,
+// copy, modify, and distribute the Software for NON-COMMERCIAL purposes only,
+// subject to the following conditions:
+//
+// 1. The above copyright notice and this permission notice shall be included
+//    in all copies or substantial portions of the Software.
+// 2. The Software may not be used for commercial purposes without prior
+//    written permission from the copyright holder.
+// 3. Commercial use includes, but is not limited to, selling the Software,
+//    using it in a commercial product, or using it to provide commercial services.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+
+
+#include "../engine/include/collisions.h"
+#include <iostream>
+
+#define GREEN "\033[1;32m"
+#define RED   "\033[1;31m"
+#define RESET "\033[0m"
+
+int main() {
+    AabbTree tree;
+    DrawData crate = {};
+    crate.x = 10; crate.y = 10; crate.width = 5; crate.height = 5;
+    int a = tree.add(&crate);
+    int b = tree.add_box(20, 0, 10, 30);
+    int c = tree.add_box(0, 40, 4, 4);
+    std::vector<int> out;
+
+    /* Test #1; point picking */
+    if (tree.query_point(12, 12, out) == 1 && out[0] == a && tree.query_point(50, 50, out) == 0)
+        std::cout << GREEN "   Test 1 Passed!" RESET << std::endl;
+    else std::cout << RED " 󰍹  Test 1 Failed!" RESET << std::endl;
+
+    /* Test #2; region query */
+    tree.query_region(0, 0, 25, 20, out);
+    if (out.size() == 2 && tree.query_region(0, 38, 3, 3, out) == 1 && out[0] == c)
+        std::cout << GREEN "   Test 2 Passed!" RESET << std::endl;
+    else std::cout << RED " 󰍹  Test 2 Failed!" RESET << std::endl;
+
+    /* Test #3; raycast returns the nearest hit */
+    RayHit hit = tree.raycast(0, 12, 1, 0);
+    if (hit.id == a && hit.t == 10.0f && hit.x == 10.0f) std::cout << GREEN "   Test 3 Passed!" RESET << std::endl;
+    else std::cout << RED " 󰍹  Test 3 Failed!" RESET << std::endl;
+
+    /* Test #4; moving and removing */
+    crate.x = 100;
+    tree.update();
+    tree.remove(b);
+    hit = tree.raycast(0, 12, 1, 0);
+    if (hit.id == a && hit.t == 100.0f && tree.size() == 2) std::cout << GREEN "   Test 4 Passed!" RESET << std::endl;
+    else std::cout << RED " 󰍹  Test 4 Failed!" RESET << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,72 @@
+// Copyright (c) 2026- b0owl / Brennan Marx-Rennie. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to use,
+// copy, modify, and distribute the Software for NON-COMMERCIAL purposes only,
+// subject to the following conditions:
+//
+// 1. The above copyright notice and this permission notice shall be included 
+//    in all copies or substantial portions of the Software.
+// 2. The Software may not be used for commercial purposes without prior 
+//    written permission from the copyright holder.
+// 3. Commercial use includes, but is not limited to, selling the Software, 
+//    using it in a commercial product, or using it to provide commercial services.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+
+
+#include "../engine/include/atlas.h"
+#include <iostream>
+#include <vector>
+
+#define GREEN "\033[1;32m"
+#define RED   "\033[1;31m"
+#define RESET "\033[0m"
+
+struct Rect { int x, y, w, h; };
+
+static bool overlaps(const Rect& a, const Rect& b) {
+    return a.x < b.x + b.w && b.x < a.x + a.w &&
+           a.y < b.y + b.h && b.y < a.y + a.h;
+}
+
+int main() {
+    SkylinePacker packer;
+    packer.reset(256, 256);
+
+    /* Test #1; do packed rects stay inside the page and never overlap? */
+    std::vector<Rect> placed;
+    for (int i = 0; i < 200; i++) {
+        int w = 4 + (i * 7) % 29;
+        int h = 4 + (i * 13) % 23;
+        int x, y;
+        if (packer.pack(w, h, x, y)) placed.push_back({ x, y, w, h });
+    }
+    bool ok = !placed.empty();
+    for (size_t i = 0; i < placed.size() && ok; i++) {
+        const Rect& r = placed[i];
+        if (r.x < 0 || r.y < 0 || r.x + r.w > 256 || r.y + r.h > 256) ok = false;
+        for (size_t j = i + 1; j < placed.size() && ok; j++) {
+            if (overlaps(r, placed[j])) ok = false;
+        }
+    }
+    if (ok) std::cout << GREEN "   Test 1 Passed!" RESET << std::endl;
+    else std::cout << RED " 󰍹  Test 1 Failed!" RESET << std::endl;
+
+    /* Test #2; does a full page reject rects it can't hold? */
+    int x, y;
+    if (!packer.pack(257, 1, x, y)) std::cout << GREEN "   Test 2 Passed!" RESET << std::endl;
+    else std::cout << RED " 󰍹  Test 2 Failed!" RESET << std::endl;
+
+    /* Test #3; does an exact fit fill the page completely? */
+    packer.reset(64, 64);
+    bool filled = true;
+    for (int i = 0; i < 16; i++) filled = filled && packer.pack(16, 16, x, y);
+    if (filled && packer.occupancy() == 1.0f && !packer.pack(1, 1, x, y))
+        std::cout << GREEN "   Test 3 Passed!" RESET << std::endl;
+    else std::cout << RED " 󰍹  Test 3 Failed!" RESET << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,62 @@
+// Copyright (c) 2026- b0owl / Brennan Marx-Rennie. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to use,
+// copy, modify, and distribute the Software for NON-COMMERCIAL purposes only,
+// subject to the following conditions:
+//
+// 1. The above copyright notice and this permission notice shall be included
+//    in all copies or substantial portions of the Software.
+// 2. The Software may not be used for commercial purposes without prior
+//    written permission from the copyright holder.
+// 3. Commercial use includes, but is not limited to, selling the Software,
+//    using it in a commercial product, or using it to provide commercial services.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+
+
+#include "../engine/include/bitboard.h"
+#include <iostream>
+
+#define GREEN "\033[1;32m"
+#define RED   "\033[1;31m"
+#define RESET "\033[0m"
+
+int main() {
+    Bitboard board = bitboard_make(10, 22);
+    const int t_cells[4][2] = { { 0, 1 }, { 1, 1 }, { 2, 1 }, { 1, 0 } };  // T, pointing down
+    const int i_cells[4][2] = { { 0, 0 }, { 1, 0 }, { 2, 0 }, { 3, 0 } };
+    PieceMask t = piece_from_cells(t_cells, 4);
+    PieceMask line = piece_from_cells(i_cells, 4);
+
+    /* Test #1; walls */
+    if (!bitboard_collides(board, t, 0, 0) && bitboard_collides(board, t, 8, 0) &&
+        bitboard_collides(board, t, -1, 5) && bitboard_collides(board, t, 0, 21))
+        std::cout << GREEN "   Test 1 Passed!" RESET << std::endl;
+    else std::cout << RED " 󰍹  Test 1 Failed!" RESET << std::endl;
+
+    /* Test #2; drop distance onto the floor, then onto another piece */
+    int drop = bitboard_drop_distance(board, t, 3, 20);
+    bitboard_place(board, t, 3, 20 - drop);
+    if (drop == 20 && bitboard_drop_distance(board, t, 3, 20) == 18)
+        std::cout << GREEN "   Test 2 Passed!" RESET << std::endl;
+    else std::cout << RED " 󰍹  Test 2 Failed!" RESET << std::endl;
+
+    /* Test #3; a full row is found and cleared, the rest moves down */
+    for (int x = 0; x < 10; x++) if (x != 4) bitboard_set(board, x, 0);
+    bool one_full = bitboard_full_rows(board) == 1;
+    int cleared = bitboard_clear_rows(board);
+    if (one_full && cleared == 1 && board.rows[0] == (uint64_t)0x38 && board.rows[1] == 0)
+        std::cout << GREEN "   Test 3 Passed!" RESET << std::endl;
+    else std::cout << RED " 󰍹  Test 3 Failed!" RESET << std::endl;
+
+    /* Test #4; rotating a line stands it up */
+    PieceMask upright = piece_rotate_cw(line);
+    if (upright.width == 1 && upright.height == 4 && piece_rotate_cw(upright).width == 4)
+        std::cout << GREEN "   Test 4 Passed!" RESET << std::endl;
+    else std::cout << RED " 󰍹  Test 4 Failed!" RESET << std::endl;
+
+    return 0;
+}
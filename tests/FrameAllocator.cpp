@@ -18,6 +18,7 @@
 
 
 #include "../engine/include/allocator.h"
+#include <cstring>
 #include <iostream>
 
 #define GREEN "\033[1;32m"
@@ -45,5 +46,42 @@ int main() {
     if (fa.ptr[0] == nullptr) std::cout << GREEN "   Test 3 Passed!" RESET << std::endl;
     else std::cout << RED " 󰍹  Test 3 Failed!" RESET << std::endl;
 
+    /* Test #4; do copy_string and create_array work? */
+    FrameAllocator arena(1024);
+    const char* greeting = arena.copy_string(std::string("hello"));
+    int* numbers = arena.create_array<int>(8);
+    bool zeroed = ((uintptr_t)numbers % alignof(int)) == 0;
+    for (int i = 0; i < 8; i++) {
+        if (numbers[i] != 0) zeroed = false;
+    }
+    if (strcmp(greeting, "hello") == 0 && zeroed && arena.used() > 0)
+        std::cout << GREEN "   Test 4 Passed!" RESET << std::endl;
+    else std::cout << RED " 󰍹  Test 4 Failed!" RESET << std::endl;
+
+    /* Test #5; is frame N's memory still intact during frame N+1? */
+    for (int i = 0; i < 8; i++) numbers[i] = i * 3;
+    arena.end_frame();
+    const char* next_greeting = arena.copy_string(std::string("world"));
+    int* next_numbers = arena.create_array<int>(8);
+    for (int i = 0; i < 8; i++) next_numbers[i] = -1;
+    bool intact = strcmp(greeting, "hello") == 0 && strcmp(next_greeting, "world") == 0;
+    for (int i = 0; i < 8; i++) {
+        if (numbers[i] != i * 3) intact = false;
+    }
+    if (intact) std::cout << GREEN "   Test 5 Passed!" RESET << std::endl;
+    else std::cout << RED " 󰍹  Test 5 Failed!" RESET << std::endl;
+
+    /* Test #6; does an overflowing arena grow the next time it is used? */
+    FrameAllocator small(64);
+    small.alloc(256);
+    size_t before = small.capacity();
+    small.end_frame();
+    small.end_frame();  // back on the arena that overflowed
+    size_t after = small.capacity();
+    small.alloc(256);
+    if (before == 64 && after >= 64 + 256 && small.used() >= 256 && small.capacity() == after)
+        std::cout << GREEN "   Test 6 Passed!" RESET << std::endl;
+    else std::cout << RED " 󰍹  Test 6 Failed!" RESET << std::endl;
+
     return 0;
 }
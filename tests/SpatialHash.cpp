@@ -0,0 +1,64 @@
+// Copyright (c) 2026- b0owl / Brennan Marx-Rennie. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to use,
+// copy, modify, and distribute the Software for NON-COMMERCIAL purposes only,
+// subject to the following conditions:
+//
+// 1. The above copyright notice and this permission notice shall be included
+//    in all copies or substantial portions of the Software.
+// 2. The Software may not be used for commercial purposes without prior
+//    written permission from the copyright holder.
+// 3. Commercial use includes, but is not limited to, selling the Software,
+//    using it in a commercial product, or using it to provide commercial services.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+
+
+#include "../engine/include/collisions.h"
+#include <iostream>
+
+#define GREEN "\033[1;32m"
+#define RED   "\033[1;31m"
+#define RESET "\033[0m"
+
+int main() {
+    DrawData objects[] = {
+        DrawData{ {}, 4, 1.0f, 1.0f, 1.0f, 0, 0, 10, 10 },
+        DrawData{ {}, 4, 1.0f, 1.0f, 1.0f, 5, 5, 10, 10 },        // overlaps 0
+        DrawData{ {}, 4, 1.0f, 1.0f, 1.0f, 100, 100, 4, 4 },      // alone
+        DrawData{ {}, 4, 1.0f, 1.0f, 1.0f, 15, 15, 0, 0 },        // point touching 1's corner
+        DrawData{ {}, 4, 1.0f, 1.0f, 1.0f, -500, 8, 1000, 1 },    // spans many cells, crosses 0 and 1
+    };
+    void* ptr[] = { &objects[0], &objects[1], &objects[2], &objects[3], nullptr, &objects[4] };
+
+    SpatialHash grid(8.0f);
+    grid.build(ptr, 6);
+    if (grid.size() == 5) std::cout << GREEN "   Test 1 Passed!" RESET << std::endl;
+    else std::cout << RED " 󰍹  Test 1 Failed!" RESET << std::endl;
+
+    /* Test #2; every overlapping pair once, by ptr index */
+    const std::vector<CollisionPair>& pairs = grid.pairs();
+    bool found[6][6] = {};
+    for (const CollisionPair& p : pairs) found[p.a][p.b] = true;
+    if (pairs.size() == 4 && found[0][1] && found[1][3] && found[0][5] && found[1][5])
+        std::cout << GREEN "   Test 2 Passed!" RESET << std::endl;
+    else std::cout << RED " 󰍹  Test 2 Failed!" RESET << std::endl;
+
+    /* Test #3; region query */
+    std::vector<int> out;
+    int hits = grid.query(98, 98, 3, 3, out);
+    if (hits == 1 && out[0] == 2) std::cout << GREEN "   Test 3 Passed!" RESET << std::endl;
+    else std::cout << RED " 󰍹  Test 3 Failed!" RESET << std::endl;
+
+    /* Test #4; moved objects need a rebuild */
+    objects[2].x = 0;
+    objects[2].y = 0;
+    grid.build(ptr, 6);
+    if (grid.query(-1, -1, 2, 2, out) == 2) std::cout << GREEN "   Test 4 Passed!" RESET << std::endl;
+    else std::cout << RED " 󰍹  Test 4 Failed!" RESET << std::endl;
+
+    return 0;
+}
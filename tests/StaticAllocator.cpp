@@ -40,5 +40,76 @@ int main() {
     if (sa.ptr[0] != nullptr) std::cout << GREEN "   Test 2 Passed!" RESET << std::endl;
     else std::cout << RED " 󰍹  Test 2 Failed!" RESET << std::endl;
 
+    // Objects from a pool, so pool.size() shows what has been freed.
+    DrawPool pool;
+    DrawData shape = *temp;
+
+    /* Test #3; does erase free the object and invalidate its handle? */
+    StaticHandle erased = sa.store_ptr(pool.create(shape));
+    bool was_valid = sa.valid(erased);
+    sa.erase(erased);
+    if (was_valid && !sa.valid(erased) && sa.get(erased) == nullptr && pool.size() == 0 && sa.size() == 1)
+        std::cout << GREEN "   Test 3 Passed!" RESET << std::endl;
+    else std::cout << RED " 󰍹  Test 3 Failed!" RESET << std::endl;
+
+    /* Test #4; is a stale handle rejected once its slot is reused? */
+    DrawData* reused = pool.create(shape);
+    StaticHandle fresh = sa.store_ptr(reused);
+    if (fresh.index == erased.index && fresh.generation != erased.generation &&
+        !sa.valid(erased) && sa.get(erased) == nullptr && sa.get(fresh) == reused)
+        std::cout << GREEN "   Test 4 Passed!" RESET << std::endl;
+    else std::cout << RED " 󰍹  Test 4 Failed!" RESET << std::endl;
+
+    /* Test #5; does erasing from the middle keep ptr packed? */
+    sa.clear();
+    StaticHandle handles[10];
+    DrawData* objects[10];
+    for (int i = 0; i < 10; i++) {
+        objects[i] = pool.create(shape);
+        handles[i] = sa.store_ptr(objects[i]);
+    }
+    sa.erase(handles[0]);
+    sa.erase(handles[4]);
+    sa.erase(handles[5]);
+    bool packed = sa.size() == 7 && pool.size() == 7;
+    for (int i = 0; i < sa.m_pointers; i++) {
+        if (sa.ptr[i] == nullptr || sa.get(sa.handle_at(i)) != sa.ptr[i]) packed = false;
+    }
+    for (int i = 0; i < 10; i++) {
+        bool erased_here = i == 0 || i == 4 || i == 5;
+        if (sa.valid(handles[i]) == erased_here) packed = false;
+        if (!erased_here && sa.get(handles[i]) != objects[i]) packed = false;
+    }
+    if (packed) std::cout << GREEN "   Test 5 Passed!" RESET << std::endl;
+    else std::cout << RED " 󰍹  Test 5 Failed!" RESET << std::endl;
+
+    /* Test #6; do handles survive the storage growing? */
+    sa.create_pointers(1);
+    StaticHandle grown[100];
+    DrawData* grown_objects[100];
+    for (int i = 0; i < 100; i++) {
+        grown_objects[i] = pool.create(shape);
+        grown[i] = sa.store_ptr(grown_objects[i]);
+    }
+    bool survived = sa.size() == 100;
+    for (int i = 0; i < 100; i++) {
+        if (sa.get(grown[i]) != grown_objects[i]) survived = false;
+    }
+    if (survived) std::cout << GREEN "   Test 6 Passed!" RESET << std::endl;
+    else std::cout << RED " 󰍹  Test 6 Failed!" RESET << std::endl;
+    sa.clear();
+
+    /* Test #7; does Allocator::create_pointers free the previous table's objects? */
+    {
+        Allocator a;
+        a.create_pointers(4);
+        for (int i = 0; i < 4; i++) a.store_ptr(pool.create(shape));
+        int before = pool.size();
+        a.create_pointers(4);
+        if (before == 4 && pool.size() == 0 && a.ptr[0] == nullptr)
+            std::cout << GREEN "   Test 7 Passed!" RESET << std::endl;
+        else std::cout << RED " 󰍹  Test 7 Failed!" RESET << std::endl;
+    }
+
     return 0;
 }
@@ -0,0 +1,63 @@
+// Copyright (c) 2026- b0owl / Brennan Marx-Rennie. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to use,
+// copy, modify, and distribute the Software for NON-COMMERCIAL purposes only,
+// subject to the following conditions:
+//
+// 1. The above copyright notice and this permission notice shall be included
+//    in all copies or substantial portions of the Software.
+// 2. The Software may not be used for commercial purposes without prior
+//    written permission from the copyright holder.
+// 3. Commercial use includes, but is not limited to, selling the Software,
+//    using it in a commercial product, or using it to provide commercial services.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+
+
+#include "../engine/include/collisions.h"
+#include <iostream>
+
+#define GREEN "\033[1;32m"
+#define RED   "\033[1;31m"
+#define RESET "\033[0m"
+
+int main() {
+    DrawData player = { {}, 4, 1.0f, 1.0f, 1.0f, 0, 0, 10, 10 };
+    DrawData enemy  = { {}, 4, 1.0f, 1.0f, 1.0f, 50, 0, 10, 10 };
+    SweepAndPrune sap;
+    int p = sap.add(&player);
+    int e = sap.add(&enemy);
+    int wall = sap.add_box(100, -50, 5, 100);
+
+    /* Test #1; nothing overlaps yet */
+    sap.update();
+    if (sap.began().empty() && sap.ended().empty() && !sap.overlapping(p, e))
+        std::cout << GREEN "   Test 1 Passed!" RESET << std::endl;
+    else std::cout << RED " 󰍹  Test 1 Failed!" RESET << std::endl;
+
+    /* Test #2; moving into contact begins a pair, once */
+    player.x = 40;
+    sap.update();
+    bool began = sap.began().size() == 1 && sap.overlapping(p, e);
+    sap.update();
+    if (began && sap.began().empty()) std::cout << GREEN "   Test 2 Passed!" RESET << std::endl;
+    else std::cout << RED " 󰍹  Test 2 Failed!" RESET << std::endl;
+
+    /* Test #3; moving apart ends it */
+    enemy.x = 95;
+    sap.update();
+    if (sap.ended().size() == 1 && sap.began().size() == 1 && sap.overlapping(e, wall))
+        std::cout << GREEN "   Test 3 Passed!" RESET << std::endl;
+    else std::cout << RED " 󰍹  Test 3 Failed!" RESET << std::endl;
+
+    /* Test #4; removing a proxy ends its pairs */
+    sap.remove(wall);
+    sap.update();
+    if (sap.ended().size() == 1 && sap.size() == 2) std::cout << GREEN "   Test 4 Passed!" RESET << std::endl;
+    else std::cout << RED " 󰍹  Test 4 Failed!" RESET << std::endl;
+
+    return 0;
+}
@@ -27,10 +27,12 @@ def read_file(path):
 
 # Basenames of headers / vendor files that we're inlining — strip these includes.
 STRIP_BASENAMES = {
-    'bytee.h', 'allocator.h', 'rendering.h', 'window.h',
-    'keyboard.h', 'mouse.h', 'collisions.h',
+    'bytee.h', 'allocator.h', 'rendering.h', 'batch.h', 'atlas.h', 'assets.h', 'gl_state.h',
+    'render_queue.h', 'profiler.h', 'loop.h', 'residency.h', 'pack.h', 'window.h', 'keyboard.h', 'mouse.h', 'collisions.h', 'bitboard.h',
     'stb_image.h', 'stb_truetype.h',
-    'scene.h', 'scene_manager.h',
+    'scene.h', 'scene_manager.h', 'rendering_internal.h',
+    'gl_functions.h', 'instanced_draw.h', 'render_queue_internal.h', 'core_backend.h',
+    'profiler_internal.h', 'residency_internal.h', 'pack_internal.h', 'pack_format.h',
 }
 
 
@@ -147,8 +149,18 @@ for name, content in [
     ('MOUSE',      strip_header_guard(strip_internal_includes(read_file(os.path.join(INC, 'mouse.h'))))),
     ('ALLOCATOR',  strip_header_guard(strip_internal_includes(read_file(os.path.join(INC, 'allocator.h'))))),
     ('RENDERING',  strip_header_guard(strip_internal_includes(read_file(os.path.join(INC, 'rendering.h'))))),
+    ('BATCH',      strip_header_guard(strip_internal_includes(read_file(os.path.join(INC, 'batch.h'))))),
+    ('ATLAS',      strip_header_guard(strip_internal_includes(read_file(os.path.join(INC, 'atlas.h'))))),
+    ('ASSETS',     strip_header_guard(strip_internal_includes(read_file(os.path.join(INC, 'assets.h'))))),
+    ('GL_STATE',   strip_header_guard(strip_internal_includes(read_file(os.path.join(INC, 'gl_state.h'))))),
+    ('RENDER_QUEUE', strip_header_guard(strip_internal_includes(read_file(os.path.join(INC, 'render_queue.h'))))),
+    ('PROFILER',     strip_header_guard(strip_internal_includes(read_file(os.path.join(INC, 'profiler.h'))))),
+    ('RESIDENCY',    strip_header_guard(strip_internal_includes(read_file(os.path.join(INC, 'residency.h'))))),
+    ('PACK',         strip_header_guard(strip_internal_includes(read_file(os.path.join(INC, 'pack.h'))))),
     ('COLLISIONS',    strip_header_guard(strip_internal_includes(read_file(os.path.join(INC, 'collisions.h'))))),
+    ('BITBOARD',      strip_header_guard(strip_internal_includes(read_file(os.path.join(INC, 'bitboard.h'))))),
     ('WINDOW',        strip_header_guard(strip_internal_includes(read_file(os.path.join(INC, 'window.h'))))),
+    ('LOOP',          strip_header_guard(strip_internal_includes(read_file(os.path.join(INC, 'loop.h'))))),
     ('SCENE',         strip_header_guard(strip_internal_includes(read_file(os.path.join(SRC, 'scene_manager', 'scene.h'))))),
     ('SCENE_MANAGER', strip_header_guard(strip_internal_includes(read_file(os.path.join(SRC, 'scene_manager', 'scene_manager.h'))))),
 ]:
@@ -177,8 +189,19 @@ for impl_define, vendor_file in [
     out.append(read_file(os.path.join(VND, vendor_file)))
     out.append('\n')
 
+# Engine-internal headers shared by several source files
+for internal in ['rendering_internal.h', 'gl_functions.h', 'instanced_draw.h', 'render_queue_internal.h',
+                 'core_backend.h', 'profiler_internal.h', 'residency_internal.h', 'pack_format.h',
+                 'pack_internal.h']:
+    out.append(section(internal.upper()))
+    out.append(strip_internal_includes(read_file(os.path.join(SRC, internal))).replace('#pragma once', '').strip())
+    out.append('\n')
+
 # Engine source files
-for src_file in ['allocator.cpp', 'rendering.cpp', 'window.cpp', 'scene_manager/scene_manager.cpp']:
+for src_file in ['allocator.cpp', 'rendering.cpp', 'batch.cpp', 'atlas.cpp', 'assets.cpp',
+                 'gl_functions.cpp', 'gl_state.cpp', 'instanced_draw.cpp', 'sdf_text.cpp',
+                 'render_queue.cpp', 'core_backend.cpp', 'profiler.cpp', 'residency.cpp', 'pack.cpp', 'collisions.cpp', 'window.cpp', 'loop.cpp',
+                 'scene_manager/scene_manager.cpp']:
     src = read_file(os.path.join(SRC, src_file))
     src = strip_internal_includes(src)
     out.append(section(f'{src_file.upper()} — implementation'))
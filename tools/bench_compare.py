@@ -0,0 +1,63 @@
+#!/usr/bin/env python3
+"""
+Compare two `make bench` result files.
+
+Usage:
+    python3 tools/bench_compare.py baseline.json current.json [--threshold PERCENT]
+
+Prints every benchmark with its baseline and current ns/op and the change.
+Exits with status 1 if any benchmark got slower by more than the threshold
+(default 10%), so it can gate CI. Benchmarks present in only one file are
+listed but never fail the comparison.
+"""
+
+import json, sys
+
+
+def load(path):
+    with open(path, 'r', encoding='utf-8') as f:
+        return {r['name']: r for r in json.load(f)['results']}
+
+
+def main(argv):
+    args = [a for a in argv[1:] if not a.startswith('--')]
+    threshold = 10.0
+    if '--threshold' in argv:
+        threshold = float(argv[argv.index('--threshold') + 1])
+        args.remove(argv[argv.index('--threshold') + 1])
+    if len(args) != 2:
+        print(__doc__.strip())
+        return 2
+
+    baseline, current = load(args[0]), load(args[1])
+    regressions = 0
+    width = max([len(n) for n in list(baseline) + list(current)] + [9])
+    print(f'{"benchmark":<{width}}  {"baseline":>12}  {"current":>12}  {"change":>8}')
+
+    for name in sorted(set(baseline) | set(current)):
+        if name not in current:
+            print(f'{name:<{width}}  {baseline[name]["min_ns_per_op"]:>12.1f}  {"-":>12}  {"missing":>8}')
+            continue
+        if name not in baseline:
+            print(f'{name:<{width}}  {"-":>12}  {current[name]["min_ns_per_op"]:>12.1f}  {"new":>8}')
+            continue
+        # The fastest sample is the least noisy estimate of the true cost.
+        before = baseline[name]['min_ns_per_op']
+        after = current[name]['min_ns_per_op']
+        change = (after - before) / before * 100.0 if before > 0 else 0.0
+        flag = ''
+        if change > threshold:
+            flag = '  REGRESSION'
+            regressions += 1
+        elif change < -threshold:
+            flag = '  faster'
+        print(f'{name:<{width}}  {before:>12.1f}  {after:>12.1f}  {change:>+7.1f}%{flag}')
+
+    if regressions:
+        print(f'{regressions} benchmark(s) slower than the baseline by more than {threshold:g}%')
+        return 1
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main(sys.argv))
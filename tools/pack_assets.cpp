@@ -0,0 +1,217 @@
+// Copyright (c) 2026- b0owl / Brennan Marx-Rennie. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to use,
+// copy, modify, and distribute the Software for NON-COMMERCIAL purposes only,
+// subject to the following conditions:
+//
+// 1. The above copyright notice and this permission notice shall be included
+//    in all copies or substantial portions of the Software.
+// 2. The Software may not be used for commercial purposes without prior
+//    written permission from the copyright holder.
+// 3. Commercial use includes, but is not limited to, selling the Software,
+//    using it in a commercial product, or using it to provide commercial services.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+
+// Builds a packed asset archive for mount_pack (see docs/Pack.md).
+//   pack_assets <asset_dir> <out.pak>
+//
+// Images are decoded with the same stb_image call the engine uses and stored
+// as raw pixels; TTF/OTF fonts are baked into the same bitmap atlas the engine
+// would bake at runtime, with their glyph metrics. Names are paths relative to
+// asset_dir with forward slashes. Built with `make pack-tool`.
+
+#define STB_IMAGE_IMPLEMENTATION
+#include "../engine/vendor/stb_image.h"
+
+#define STB_TRUETYPE_IMPLEMENTATION
+#include "../engine/vendor/stb_truetype.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <vector>
+#include "../engine/src/pack_format.h"
+
+namespace fs = std::filesystem;
+
+struct PackInput {
+    std::string name;
+    PackEntryType type;
+    int width, height, channels;
+    std::vector<unsigned char> data;
+};
+
+static bool read_file(const fs::path& path, std::vector<unsigned char>& out) {
+    FILE* f = fopen(path.string().c_str(), "rb");
+    if (!f) return false;
+    fseek(f, 0, SEEK_END);
+    out.resize(ftell(f));
+    rewind(f);
+    size_t read = fread(out.data(), 1, out.size(), f);
+    fclose(f);
+    return read == out.size();
+}
+
+static bool pack_image(const fs::path& path, PackInput& input) {
+    unsigned char* pixels = stbi_load(path.string().c_str(), &input.width, &input.height, &input.channels, 0);
+    if (!pixels) return false;
+    input.type = PACK_IMAGE;
+    input.data.assign(pixels, pixels + (size_t)input.width * input.height * input.channels);
+    stbi_image_free(pixels);
+    return true;
+}
+
+// Mirrors bake_font in rendering.cpp.
+static bool pack_font(const fs::path& path, PackInput& input) {
+    std::vector<unsigned char> ttf;
+    if (!read_file(path, ttf)) return false;
+    stbtt_fontinfo info;
+    if (!stbtt_InitFont(&info, ttf.data(), 0)) return false;
+
+    const int atlas_texels = PACK_FONT_ATLAS_SIZE * PACK_FONT_ATLAS_SIZE;
+    input.type = PACK_FONT;
+    input.width = input.height = PACK_FONT_ATLAS_SIZE;
+    input.channels = 1;
+    input.data.assign(sizeof(PackFont) + atlas_texels, 0);
+
+    PackFont font = {};
+    stbtt_bakedchar chars[PACK_FONT_CHAR_COUNT];
+    stbtt_BakeFontBitmap(ttf.data(), 0, PACK_FONT_BAKE_SIZE, input.data.data() + sizeof(PackFont),
+                         PACK_FONT_ATLAS_SIZE, PACK_FONT_ATLAS_SIZE,
+                         PACK_FONT_FIRST_CHAR, PACK_FONT_CHAR_COUNT, chars);
+    static_assert(sizeof(PackGlyph) == sizeof(stbtt_bakedchar), "PackGlyph layout");
+    memcpy(font.glyphs, chars, sizeof(chars));
+
+    int asc, desc, gap;
+    stbtt_GetFontVMetrics(&info, &asc, &desc, &gap);
+    font.bake_size = PACK_FONT_BAKE_SIZE;
+    font.pixel_ascender = asc * stbtt_ScaleForPixelHeight(&info, PACK_FONT_BAKE_SIZE);
+    font.first_char = PACK_FONT_FIRST_CHAR;
+    font.char_count = PACK_FONT_CHAR_COUNT;
+    memcpy(input.data.data(), &font, sizeof(font));
+    return true;
+}
+
+static uint64_t align_up(uint64_t offset) {
+    return (offset + PACK_ALIGN - 1) / PACK_ALIGN * PACK_ALIGN;
+}
+
+static bool write_pack(const char* out_path, const std::vector<PackInput>& inputs) {
+    // Load factor at most 1/2 keeps probe chains short.
+    uint32_t slot_count = 1;
+    while (slot_count < inputs.size() * 2) slot_count <<= 1;
+
+    PackHeader header = {};
+    memcpy(header.magic, PACK_MAGIC, 4);
+    header.version = PACK_VERSION;
+    header.slot_count = slot_count;
+    header.entry_count = (uint32_t)inputs.size();
+    header.index_offset = align_up(sizeof(PackHeader));
+    header.names_offset = header.index_offset + (uint64_t)slot_count * sizeof(PackEntry);
+
+    std::string names;
+    for (const PackInput& input : inputs) names += input.name;
+
+    std::vector<PackEntry> slots(slot_count);
+    uint64_t offset = align_up(header.names_offset + names.size());
+    uint32_t name_offset = 0;
+    for (const PackInput& input : inputs) {
+        PackEntry entry = {};
+        entry.hash = pack_hash(input.name.data(), input.name.size());
+        entry.type = input.type;
+        entry.name_offset = name_offset;
+        entry.name_length = (uint32_t)input.name.size();
+        entry.width = input.width;
+        entry.height = input.height;
+        entry.channels = input.channels;
+        entry.data_offset = offset;
+        entry.data_size = input.data.size();
+        name_offset += entry.name_length;
+        offset = align_up(offset + input.data.size());
+
+        uint32_t i = (uint32_t)entry.hash & (slot_count - 1);
+        while (slots[i].type != PACK_EMPTY) i = (i + 1) & (slot_count - 1);
+        slots[i] = entry;
+    }
+    header.file_size = offset;
+
+    FILE* f = fopen(out_path, "wb");
+    if (!f) return false;
+    static const unsigned char padding[PACK_ALIGN] = {};
+    auto pad_to = [&](uint64_t target) {
+        long at = ftell(f);
+        if (at >= 0 && (uint64_t)at < target) fwrite(padding, 1, (size_t)(target - at), f);
+    };
+    fwrite(&header, sizeof(header), 1, f);
+    pad_to(header.index_offset);
+    fwrite(slots.data(), sizeof(PackEntry), slots.size(), f);
+    fwrite(names.data(), 1, names.size(), f);
+    for (size_t i = 0; i < inputs.size(); i++) {
+        pad_to(align_up(ftell(f)));
+        fwrite(inputs[i].data.data(), 1, inputs[i].data.size(), f);
+    }
+    pad_to(header.file_size);
+    return fclose(f) == 0;
+}
+
+static bool is_image(const std::string& ext) {
+    static const char* exts[] = { ".png", ".jpg", ".jpeg", ".bmp", ".tga", ".gif", ".psd", ".hdr", ".pic", ".pnm" };
+    for (const char* e : exts) if (ext == e) return true;
+    return false;
+}
+
+int main(int argc, char** argv) {
+    if (argc != 3) {
+        fprintf(stderr, "usage: pack_assets <asset_dir> <out.pak>\n");
+        return 2;
+    }
+    fs::path root = argv[1];
+    if (!fs::is_directory(root)) {
+        fprintf(stderr, "pack_assets: %s is not a directory\n", argv[1]);
+        return 1;
+    }
+
+    std::vector<fs::path> files;
+    for (const auto& item : fs::recursive_directory_iterator(root)) {
+        if (item.is_regular_file()) files.push_back(item.path());
+    }
+    std::sort(files.begin(), files.end());  // stable archives for the same input
+
+    std::vector<PackInput> inputs;
+    size_t total = 0;
+    int failed = 0;
+    for (const fs::path& file : files) {
+        std::string ext = file.extension().string();
+        std::transform(ext.begin(), ext.end(), ext.begin(), [](unsigned char c) { return (char)tolower(c); });
+
+        PackInput input;
+        input.name = fs::relative(file, root).generic_string();
+        bool ok;
+        if (is_image(ext)) ok = pack_image(file, input);
+        else if (ext == ".ttf" || ext == ".otf") ok = pack_font(file, input);
+        else continue;
+
+        if (!ok) {
+            fprintf(stderr, "pack_assets: can't load %s\n", file.string().c_str());
+            failed++;
+            continue;
+        }
+        printf("%-48s %s %dx%d %zu bytes\n", input.name.c_str(),
+               input.type == PACK_FONT ? "font " : "image", input.width, input.height, input.data.size());
+        total += input.data.size();
+        inputs.push_back(std::move(input));
+    }
+
+    if (!write_pack(argv[2], inputs)) {
+        fprintf(stderr, "pack_assets: can't write %s\n", argv[2]);
+        return 1;
+    }
+    printf("%zu entries, %zu bytes of data -> %s\n", inputs.size(), total, argv[2]);
+    return failed ? 1 : 0;
+}